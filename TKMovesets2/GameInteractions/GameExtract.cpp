@@ -10,18 +10,110 @@
 
 // -- Private methods -- //
 
-void GameExtract::LoadCharacterNames()
+void GameExtract::LoadCharacterNames(bool force)
 {
+	std::vector<gameAddr> playerAddresses = m_extractor->GetCharacterAddresses();
+	std::vector<uint64_t> movesetPtrs = m_extractor->GetPlayerMovesetPtrs(playerAddresses);
+
+	if (!force && playerAddresses == m_loadedPlayerAddresses && movesetPtrs == m_loadedMovesetPtrs) {
+		// Same characters as last time
+		return;
+	}
+
 	uint8_t playerId = 0;
-	for (gameAddr playerAddress : m_extractor->GetCharacterAddresses()) {
-		characterNames[playerId++] = m_extractor->GetPlayerCharacterName(playerAddress);
+	bool namesComplete = true;
+	for (std::string& name : m_extractor->GetPlayerCharacterNames(playerAddresses)) {
+		// A moveset without a name might still be getting loaded, try again next time
+		if (name.size() == 0 && movesetPtrs[playerId] != 0) {
+			namesComplete = false;
+		}
+		characterNames[playerId++] = name;
+	}
+
+	if (!namesComplete) {
+		m_loadedPlayerAddresses.clear();
+		m_loadedMovesetPtrs.clear();
+		return;
+	}
+
+	m_loadedPlayerAddresses = std::move(playerAddresses);
+	m_loadedMovesetPtrs = std::move(movesetPtrs);
+}
+
+void GameExtract::SaveExtractionSnapshot(gameAddr playerAddress, ExtractSettings settings)
+{
+	GameProcessSnapshot* snapshot = process.StopRecording();
+	if (snapshot == nullptr) {
+		return;
+	}
+
+	snapshot->gameId = currentGame->gameId;
+	snapshot->minorVersion = currentGame->minorVersion;
+	snapshot->baseAddr = game.baseAddr;
+	snapshot->playerAddress = playerAddress;
+	snapshot->extractSettings = settings & ~ExtractSettings_RecordSnapshot;
+
+	CreateDirectoryA(INTERFACE_DATA_DIR, nullptr);
+	CreateDirectoryA(EXTRACTION_SNAPSHOT_DIR, nullptr);
+
+	std::string filename = EXTRACTION_SNAPSHOT_DIR "/" + Helpers::formatDateTime(Helpers::getCurrentTimestamp(), true, true) + EXTRACTION_SNAPSHOT_EXTENSION;
+	snapshot->Save(Helpers::string_to_wstring(filename));
+	delete snapshot;
+}
+
+bool GameExtract::RunExtractionJobs(const std::vector<std::pair<gameAddr, ExtractSettings>>& jobs)
+{
+	// Extractors store scratch data while working: every job gets its own instance
+	// Constructing them is done here and not in the jobs, as the constructor writes to our shared GameData
+	std::vector<Extractor*> extractors;
+	for (size_t i = 0; i < jobs.size(); ++i) {
+		extractors.push_back(i == 0 ? m_extractor : Games::FactoryGetExtractor(currentGame, process, game));
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_jobsMutex);
+		m_jobsProgress = std::vector<std::atomic<uint8_t>>(jobs.size());
+	}
+
+	std::vector<ExtractionErrcode_> errors(jobs.size(), ExtractionErrcode_Successful);
+	{
+		// The movesets are not expected to change while we extract them, every page only has to be read once
+		GameProcessReadCacheScope readCache(process);
+		Helpers::ParallelFor(jobs.size(), [&](size_t i) {
+			auto& [playerAddress, settings] = jobs[i];
+			errors[i] = extractors[i]->Extract(playerAddress, settings, m_jobsProgress[i]);
+		}, EXTRACTION_MAX_PARALLEL_JOBS);
+	}
+
+	for (size_t i = 1; i < extractors.size(); ++i) {
+		delete extractors[i];
+	}
+
+	std::lock_guard<std::mutex> lock(m_jobsMutex);
+
+	unsigned int totalProgress = 0;
+	for (auto& jobProgress : m_jobsProgress) {
+		totalProgress += jobProgress;
+	}
+	progress = (uint8_t)(totalProgress / m_jobsProgress.size());
+	m_jobsProgress.clear();
+
+	bool errored = false;
+	for (ExtractionErrcode_ err : errors)
+	{
+		if (err != ExtractionErrcode_Successful) {
+			m_errors.push_back(err);
+			errored = true;
+		}
 	}
+	return !errored;
 }
 
 void GameExtract::OnProcessAttach()
 {
 	InstantiateFactory();
-	LoadCharacterNames();
+	LoadCharacterNames(true);
+	std::lock_guard<std::mutex> lock(m_jobsMutex);
 	m_extractionQueue.clear();
 }
 
@@ -38,20 +130,47 @@ void GameExtract::RunningUpdate()
 	// Load character name for fancy live displaying : You know who you're extracting
 	LoadCharacterNames();
 
-	// Extraction queue is a FIFO (first in first out) queue
+	// Extraction queue is a FIFO (first in first out) queue, consecutive extractions are ran together
 	bool errored = false;
-	while (m_extractionQueue.size() > 0)
+	while (true)
 	{
-		if (!errored) {
+		std::vector<std::pair<gameAddr, ExtractSettings>> jobs;
+		{
+			std::lock_guard<std::mutex> lock(m_jobsMutex);
+			if (m_extractionQueue.size() == 0) {
+				break;
+			}
+
+			// Recording a snapshot requires the extraction to be the only one reading the process
+			if (m_extractionQueue.front().second & ExtractSettings_RecordSnapshot) {
+				jobs.push_back(m_extractionQueue.front());
+				m_extractionQueue.pop_front();
+			}
+			else {
+				while (m_extractionQueue.size() > 0 && !(m_extractionQueue.front().second & ExtractSettings_RecordSnapshot)) {
+					jobs.push_back(m_extractionQueue.front());
+					m_extractionQueue.pop_front();
+				}
+			}
+			m_runningJobs = jobs.size();
+		}
+
+		if (!errored)
+		{
 			// Start extraction
-			auto&[ playerAddress, settings ] = m_extractionQueue[0];
-			ExtractionErrcode_ err = m_extractor->Extract(playerAddress, settings, progress);
-			if (err != ExtractionErrcode_Successful) {
-				m_errors.push_back(err);
-				errored = true;
+			bool recordSnapshot = (jobs[0].second & ExtractSettings_RecordSnapshot) != 0;
+
+			if (recordSnapshot) {
+				process.StartRecording();
+			}
+
+			errored = !RunExtractionJobs(jobs);
+
+			if (recordSnapshot) {
+				SaveExtractionSnapshot(jobs[0].first, jobs[0].second);
 			}
 		}
-		m_extractionQueue.erase(m_extractionQueue.begin());
+		m_runningJobs = 0;
 	}
 }
 
@@ -71,6 +190,7 @@ void GameExtract::StopThreadAndCleanup()
 {
 	// Order thread to stop
 	m_threadStarted = false;
+	WakeThread();
 	m_t.join();
 
 	if (m_extractor != nullptr) {
@@ -93,24 +213,54 @@ bool GameExtract::CanStart(bool cached) const
 bool GameExtract::IsBusy() const
 {
 	// There are still playerAddresss to extract from
-	return m_extractionQueue.size() > 0;
+	std::lock_guard<std::mutex> lock(m_jobsMutex);
+	return m_extractionQueue.size() > 0 || m_runningJobs > 0;
 }
 
-void GameExtract::QueueCharacterExtraction(int playerId, ExtractSettings settings)
+uint8_t GameExtract::GetProgress() const
 {
-	// It is safe to call this function even while an extraction is ongoing
+	std::lock_guard<std::mutex> lock(m_jobsMutex);
+	if (m_jobsProgress.size() == 0) {
+		return progress;
+	}
+
+	unsigned int totalProgress = 0;
+	for (auto& jobProgress : m_jobsProgress) {
+		totalProgress += jobProgress;
+	}
+	return (uint8_t)(totalProgress / m_jobsProgress.size());
+}
+
+std::vector<uint8_t> GameExtract::GetJobsProgress() const
+{
+	std::lock_guard<std::mutex> lock(m_jobsMutex);
+	std::vector<uint8_t> jobsProgress;
+	for (auto& jobProgress : m_jobsProgress) {
+		jobsProgress.push_back(jobProgress);
+	}
+	return jobsProgress;
+}
 
+void GameExtract::QueueCharacterExtraction(int playerId, ExtractSettings settings)
+{
+	// The addresses are read from the game before locking, the extraction thread shouldn't wait on our process reads
+	std::vector<gameAddr> playerAddresses;
 	if (playerId == -1) {
 		// Queue the extraction of every character one by one
-		for (gameAddr playerAddress : m_extractor->GetCharacterAddresses()) {
-			m_extractionQueue.push_back(std::pair<gameAddr, ExtractSettings>(playerAddress, settings));
-		}
+		playerAddresses = m_extractor->GetCharacterAddresses();
 	}
 	else {
 		// Queue the extraction of one character
-		gameAddr playerAddress = m_extractor->GetCharacterAddress(playerId);
+		playerAddresses.push_back(m_extractor->GetCharacterAddress(playerId));
+	}
+
+	// It is safe to call this function even while an extraction is ongoing
+	std::lock_guard<std::mutex> lock(m_jobsMutex);
+	for (gameAddr playerAddress : playerAddresses) {
 		m_extractionQueue.push_back(std::pair<gameAddr, ExtractSettings>(playerAddress, settings));
 	}
+
+	WakeThread();
 }
 
 void GameExtract::FreeExpiredFactoryClasses()
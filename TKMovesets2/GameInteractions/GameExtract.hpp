@@ -1,5 +1,9 @@
 #pragma once
 
+#include <deque>
+#include <mutex>
+#include <atomic>
+
 #include "Extractor.hpp"
 #include "GameInteraction.hpp"
 
@@ -9,16 +13,30 @@ class GameExtract : public virtual GameInteraction
 {
 private:
 	// Player addresses to extract and their respective extraction settings
-	std::vector<std::pair<gameAddr, ExtractSettings>> m_extractionQueue;
+	std::deque<std::pair<gameAddr, ExtractSettings>> m_extractionQueue;
+	// Amount of extractions taken out of the queue that are still running
+	std::atomic<size_t> m_runningJobs = 0;
+	// Progress of every running extraction, between 0 and 100. The list is only replaced under the lock, its values are written by the jobs without it.
+	std::vector<std::atomic<uint8_t>> m_jobsProgress;
+	// Protects the queue and the jobs progress list, the queue being filled from the display thread
+	mutable std::mutex m_jobsMutex;
 	// List of errors, one extraction fail = 1 error
 	std::vector<ExtractionErrcode_> m_errors;
 	// Extractor class, never stores an Extractor*, used for polymorphism
 	Extractor* m_extractor = nullptr;
 	// Extractor class that is going to be freed next FreeExpiredFactoryClasses() call
 	Extractor* m_toFree_extractor = nullptr;
+	// Player addresses and moveset ptrs the character names were last loaded from, names are only read again when these change
+	std::vector<gameAddr> m_loadedPlayerAddresses;
+	std::vector<uint64_t> m_loadedMovesetPtrs;
 
 	// Reads the movesets for the players characters' names. Accessible under .characterNames
-	void LoadCharacterNames();
+	// Names are only read again if a player or its moveset changed since the last call, unless [force] is true
+	void LoadCharacterNames(bool force=false);
+	// Stops the process recording and saves it along with what is needed to replay the extraction
+	void SaveExtractionSnapshot(gameAddr playerAddress, ExtractSettings settings);
+	// Runs every given extraction concurrently, each with its own extractor. Returns false if any of them failed.
+	bool RunExtractionJobs(const std::vector<std::pair<gameAddr, ExtractSettings>>& jobs);
 	// Callback called whenever the process is re-atached
 	void OnProcessAttach() override;
 	// Instantiate an extractor with polymorphism, also destroy the old one
@@ -37,6 +55,10 @@ public:
 	bool IsBusy() const override;
 	// Queue a character extraction. -1 of all characters
 	void QueueCharacterExtraction(int playerId, ExtractSettings settings=0);
+	// Returns the average progress of the running extractions, or the progress of the last ones if none are running
+	uint8_t GetProgress() const;
+	// Returns the progress of every running extraction
+	std::vector<uint8_t> GetJobsProgress() const;
 	// Returns an error code to consume instantly through a popup, sound player or such
 	ExtractionErrcode_ GetLastError();
 	// Frees the factory-obtained class we allocated earlier
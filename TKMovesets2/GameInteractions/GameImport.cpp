@@ -84,6 +84,7 @@ void GameImport::StopThreadAndCleanup()
 {
 	// Order thread to stop
 	m_threadStarted = false;
+	WakeThread();
 	m_t.join();
 
 	if (m_importer != nullptr) {
@@ -135,6 +136,7 @@ void GameImport::QueueCharacterImportationOnBothPlayers(const Byte* moveset, uin
 		.settings = settings,
 		.out_moveset = out_moveset2
 		});
+	WakeThread();
 }
 
 void GameImport::QueueCharacterImportation(int playerid, const Byte* moveset, uint64_t movesetSize, ImportSettings settings, gameAddr* out_moveset)
@@ -149,6 +151,7 @@ void GameImport::QueueCharacterImportation(int playerid, const Byte* moveset, ui
 		.settings = settings,
 		.out_moveset = out_moveset
 		});
+	WakeThread();
 }
 
 void GameImport::QueueCharacterImportation(const Byte* moveset, uint64_t movesetSize, ImportSettings settings, gameAddr* out_moveset)
@@ -163,6 +166,7 @@ void GameImport::QueueCharacterImportation(const Byte* moveset, uint64_t moveset
 		.settings = settings,
 		.out_moveset = out_moveset
 		});
+	WakeThread();
 }
 
 void GameImport::QueueCharacterImportation(std::wstring filename, ImportSettings settings, gameAddr* out_moveset)
@@ -177,6 +181,7 @@ void GameImport::QueueCharacterImportation(std::wstring filename, ImportSettings
 		.settings = settings,
 		.out_moveset = out_moveset
 	});
+	WakeThread();
 }
 
 gameAddr GameImport::GetCurrentPlayerMovesetAddr() const
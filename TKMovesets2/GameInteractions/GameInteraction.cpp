@@ -23,15 +23,20 @@ void GameInteraction::SetTargetProcess(const GameInfo* gameInfo)
 		process.Detach();
 		OnProcessDetach();
 	}
+
+	// Try to attach right away
+	WakeThread();
 }
 
 void GameInteraction::Update()
 {
 	// Executed in its own thread, is the one in charge of extraction, that way it won't interrupt the GUI rendering
+	unsigned int sleepMs = GAME_INTERACTION_THREAD_SLEEP_MS;
 	while (m_threadStarted)
 	{
 		// Ensure the process is still open and valid before possibly extracting
 		if (process.IsAttached() && process.CheckRunning()) {
+			sleepMs = GAME_INTERACTION_THREAD_SLEEP_MS;
 			process.FreeOldGameMemory();
 			if (CanStart(false)) {
 				actionStartDate = Helpers::getCurrentTimestamp();
@@ -47,8 +52,17 @@ void GameInteraction::Update()
 			if (process.Attach(currentGameProcess.c_str(), m_processExtraFlags)) {
 				DEBUG_LOG("Process is now attached - OnProcessAttach()\n");
 				OnProcessAttach();
+				sleepMs = GAME_INTERACTION_THREAD_SLEEP_MS;
+			}
+			else {
+				// Looking for the process is costly, do it less and less often while the game isn't running
+				sleepMs = (sleepMs * 2 < GAME_INTERACTION_THREAD_MAX_SLEEP_MS) ? sleepMs * 2 : GAME_INTERACTION_THREAD_MAX_SLEEP_MS;
 			}
 		}
+		else {
+			// No game selected, SetTargetProcess() will wake us up
+			sleepMs = GAME_INTERACTION_THREAD_MAX_SLEEP_MS;
+		}
 
 		if (m_lastStatus != process.status) {
 			if (m_lastStatus == GameProcessErrcode_PROC_ATTACHED) {
@@ -58,7 +72,10 @@ void GameInteraction::Update()
 			m_lastStatus = process.status;
 		}
 
-		std::this_thread::sleep_for(std::chrono::milliseconds(GAME_INTERACTION_THREAD_SLEEP_MS));
+		// Queued work and target changes wake the thread up early
+		if (SleepFor(std::chrono::milliseconds(sleepMs))) {
+			sleepMs = GAME_INTERACTION_THREAD_SLEEP_MS;
+		}
 	}
 }
 
@@ -79,6 +96,7 @@ void GameInteraction::StopThreadAndCleanup()
 {
 	// Order thread to stop
 	m_threadStarted = false;
+	WakeThread();
 	m_t.join();
 }
 
@@ -23,74 +23,193 @@ gameAddr GameData::ReadPtr(gameAddr address) const
 	return value;
 }
 
-gameAddr GameData::ReadPtrPath(const char* c_addressId) const
+void GameData::ReadPtrs(const gameAddr* addresses, gameAddr* ptrs_out, size_t count) const
 {
-	if (m_ptrSize == 4) {
-		return ReadPtrPath32(c_addressId);
+	std::vector<uint64_t> values(count, 0);
+	std::vector<GameProcessReadRequest> requests;
+
+	for (size_t i = 0; i < count; ++i) {
+		requests.push_back({ .addr = addresses[i], .buf = &values[i], .size = m_ptrSize });
 	}
+	ReadBatch(requests.data(), requests.size());
 
-	bool isRelative;
-	const std::vector<gameAddr>& ptrPath = *GetPtrPath(c_addressId, isRelative);
+	for (size_t i = 0; i < count; ++i) {
+		ptrs_out[i] = requests[i].success ? DecodePtr(values[i]) : 0;
+	}
+}
 
-	if (ptrPath.size() == 0) {
-		return GAME_ADDR_NULL;
+gameAddr GameData::DecodePtr(uint64_t value) const
+{
+	if (m_ptrSize == 8) {
+		return bigEndian ? BYTESWAP_INT64(value) : value;
 	}
 
-	gameAddr addr = ptrPath[0];
-	if (isRelative) {
-		addr += m_process->mainModule.address;
+	uint32_t value32 = (uint32_t)value;
+	return bigEndian ? BYTESWAP_INT32(value32) : value32;
+}
+
+gameAddr GameData::ReadPtrPath(const char* c_addressId) const
+{
+	gameAddr addr;
+	ReadPtrPaths(&c_addressId, &addr, 1);
+	return addr;
+}
+
+void GameData::ReadPtrPaths(const char* const* c_addressIds, gameAddr* addresses_out, size_t count) const
+{
+	// Path of every address that still has to be followed, null once it is done
+	std::vector<const std::vector<gameAddr>*> ptrPaths(count, nullptr);
+	std::vector<uint64_t> values(count);
+	std::vector<GameProcessReadRequest> requests;
+	std::vector<size_t> requestOwners;
+	std::vector<size_t> relativePaths;
+	size_t maxDepth = 0;
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		bool isRelative;
+		const std::vector<gameAddr>* ptrPath = GetPtrPath(c_addressIds[i], isRelative);
+
+		if (ptrPath->size() == 0) {
+			addresses_out[i] = GAME_ADDR_NULL;
+			continue;
+		}
+
+		addresses_out[i] = (*ptrPath)[0];
+		if (isRelative) {
+			relativePaths.push_back(i);
+		}
+		else if (m_ptrSize == 4) {
+			addresses_out[i] = (gameAddr32)addresses_out[i];
+		}
+
+		if (ptrPath->size() > 1)
+		{
+			ptrPaths[i] = ptrPath;
+			if (ptrPath->size() - 1 > maxDepth) {
+				maxDepth = ptrPath->size() - 1;
+			}
+		}
 	}
 
+	if (relativePaths.size() != 0)
 	{
-		size_t pathLen = ptrPath.size() - 1;
-		if (pathLen > 0)
+		ResolveModuleOffsets(c_addressIds, relativePaths, addresses_out);
+		for (size_t i : relativePaths)
 		{
-			addr = ReadPtr(baseAddr + addr);
-			for (size_t i = 1; i < pathLen; ++i)
-			{
-				if (addr == (gameAddr)0) {
-					return GAME_ADDR_NULL;
-				}
-				addr = ReadPtr(baseAddr + addr + ptrPath[i]);
+			addresses_out[i] += m_process->mainModule.address;
+			if (m_ptrSize == 4) {
+				addresses_out[i] = (gameAddr32)addresses_out[i];
 			}
-			addr += ptrPath[pathLen];
 		}
 	}
 
-	return addr;
+	// Every path is at the same level at each iteration, so all of the ptrs of one level are read in a single batch
+	for (size_t depth = 0; depth < maxDepth; ++depth)
+	{
+		requests.clear();
+		requestOwners.clear();
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			const std::vector<gameAddr>* ptrPath = ptrPaths[i];
+			if (ptrPath == nullptr || ptrPath->size() - 1 <= depth) {
+				continue;
+			}
+
+			if (depth > 0 && addresses_out[i] == 0) {
+				addresses_out[i] = GAME_ADDR_NULL;
+				ptrPaths[i] = nullptr;
+				continue;
+			}
+
+			// Failed reads are decoded as -1, same as ReadPtr() would return
+			values[i] = (uint64_t)-1;
+			requests.push_back({
+				.addr = addresses_out[i] + (depth > 0 ? (*ptrPath)[depth] : 0),
+				.buf = &values[i],
+				.size = m_ptrSize
+			});
+			requestOwners.push_back(i);
+		}
+
+		ReadBatch(requests.data(), requests.size());
+
+		for (size_t owner : requestOwners) {
+			addresses_out[owner] = DecodePtr(values[owner]);
+		}
+	}
+
+	// Apply the last offset of every path that wasn't stopped by a null ptr
+	for (size_t i = 0; i < count; ++i)
+	{
+		if (ptrPaths[i] != nullptr)
+		{
+			addresses_out[i] += ptrPaths[i]->back();
+			if (m_ptrSize == 4) {
+				addresses_out[i] = (gameAddr32)addresses_out[i];
+			}
+		}
+	}
 }
 
-gameAddr GameData::ReadPtrPath32(const char* c_addressId) const
+void GameData::ResolveModuleOffsets(const char* const* c_addressIds, const std::vector<size_t>& indexes, gameAddr* offsets) const
 {
-	bool isRelative;
-	const std::vector<gameAddr>& ptrPath = *GetPtrPath(c_addressId, isRelative);
+	std::vector<std::string> aobKeys;
+	std::vector<const char*> patterns;
+	std::vector<size_t> patternOwners;
 
-	if (ptrPath.size() == 0) {
-		return GAME_ADDR_NULL;
+	for (size_t i : indexes)
+	{
+		std::string aobKey = std::string(c_addressIds[i]) + "_aob";
+		if (HasKey(aobKey.c_str())) {
+			patterns.push_back(GetString(aobKey.c_str()));
+			patternOwners.push_back(i);
+			aobKeys.push_back(std::move(aobKey));
+		}
 	}
 
-	gameAddr32 addr = (gameAddr32)ptrPath[0];
-	if (isRelative) {
-		addr += (gameAddr32)m_process->mainModule.address;
+	if (patterns.size() == 0) {
+		return;
 	}
 
+	// Every pattern is looked for in a single scan, which is skipped entirely for the patterns found in a previous one
+	std::vector<gameAddr> matches = m_process->AOBScan(patterns);
+
+	for (size_t p = 0; p < patterns.size(); ++p)
 	{
-		size_t pathLen = ptrPath.size() - 1;
-		if (pathLen > 0)
+		size_t i = patternOwners[p];
+		gameAddr match = matches[p];
+		if (match == 0) {
+			DEBUG_LOG("AOB of '%s' not found, using its static offset\n", c_addressIds[i]);
+			continue;
+		}
+
+		std::string dispKey = aobKeys[p] + "_disp";
+		if (HasKey(dispKey.c_str()))
 		{
-			addr = (gameAddr32)ReadPtr(baseAddr + addr);
-			for (size_t i = 1; i < pathLen; ++i)
-			{
-				if (addr == (gameAddr32)0) {
-					return GAME_ADDR_NULL;
-				}
-				addr = (gameAddr32)ReadPtr(baseAddr + addr + ptrPath[i]);
-			}
-			addr += (gameAddr32)ptrPath[pathLen];
+			// The pattern matches an instruction referencing the address relatively to the end of its 4 bytes displacement
+			gameAddr dispAddr = match + GetValue(dispKey.c_str());
+			offsets[i] = dispAddr + 4 + m_process->readInt32(dispAddr) - m_process->mainModule.address;
+		}
+		else {
+			offsets[i] = match - m_process->mainModule.address;
 		}
 	}
+}
 
-	return addr;
+bool GameData::ReadBatch(GameProcessReadRequest* requests, size_t count) const
+{
+	for (size_t i = 0; i < count; ++i) {
+		requests[i].addr += baseAddr;
+	}
+
+	bool result = m_process->readBatch(requests, count);
+
+	for (size_t i = 0; i < count; ++i) {
+		requests[i].addr -= baseAddr;
+	}
+	return result;
 }
 
 void GameData::ReadBytes(gameAddr address, void* buf, size_t readSize) const
@@ -17,9 +17,12 @@ private:
 	unsigned int m_ptrSize = 8;
 	// Stores current game informations
 	const GameInfo* currentGame = nullptr;
-	
-	// Reads a ptr path from an address identifier and return its last pointer
-	gameAddr ReadPtrPath32(const char* c_addressId) const;
+
+	// Decodes a ptr read from the game, taking into account the ptr size and endian
+	gameAddr DecodePtr(uint64_t value) const;
+	// Replaces the static module offsets of the given relative ptr paths by the ones found through their '<id>_aob' pattern, for the ptr paths that have one
+	// With '<id>_aob_disp', the offset is read from the RIP-relative displacement located that many bytes after the match instead of being the match itself
+	void ResolveModuleOffsets(const char* const* c_addressIds, const std::vector<size_t>& indexes, gameAddr* offsets) const;
 public:
 	// For games where PTRs are read from a base memory area (like emulators)
 	uint64_t baseAddr = 0;
@@ -53,11 +56,18 @@ public:
 
 	// Reads a ptr, reads 4 or 8 bytes depending on the ptr size, taking into account base address and endian
 	gameAddr ReadPtr(gameAddr address) const;
+	// Reads [count] ptrs at once, with the game's ptr size and endianness. Failed reads give 0.
+	void ReadPtrs(const gameAddr* addresses, gameAddr* ptrs_out, size_t count) const;
 	// Reads [readSize] amounts of bytes from the game and write them to the provided buffer, applies base address before reading
 	void ReadBytes(gameAddr address, void* buf, size_t readSize) const;
 
+	// Reads multiple independent areas at once, applying the base address to each of them. No endian correction is done.
+	bool ReadBatch(GameProcessReadRequest* requests, size_t count) const;
+
 	// Reads a ptr path
 	gameAddr ReadPtrPath(const char* c_addressId) const;
+	// Reads multiple ptr paths at once, following them one level at a time so that every level only costs a single batch of reads
+	void ReadPtrPaths(const char* const* c_addressIds, gameAddr* addresses_out, size_t count) const;
 
 	void SetProcess(GameProcess* process, GameAddressesFile* t_addrFile)
 	{
@@ -3,6 +3,7 @@
 
 #include "GameProcess.hpp"
 #include "Helpers.hpp"
+#include "AOBScan.hpp"
 
 #include "constants.h"
 
@@ -168,6 +169,10 @@ DWORD GameProcess::GetGamePID(const char* processName)
 
 std::vector<moduleEntry> GameProcess::GetModuleList() const
 {
+	if (m_snapshot != nullptr) {
+		return m_snapshot->modules;
+	}
+
 	HANDLE moduleSnap;
 	MODULEENTRY32W me32{ 0 };
 
@@ -201,6 +206,24 @@ std::vector<moduleEntry> GameProcess::GetModuleList() const
 	return modules;
 }
 
+bool GameProcess::ReadRemote(gameAddr addr, void* buf, size_t readSize) const
+{
+	return ReadProcessMemory(m_processHandle, (LPCVOID)addr, (LPVOID)buf, readSize, nullptr) != 0;
+}
+
+void GameProcess::ReadRemoteBatch(GameProcessReadRequest* requests, size_t count) const
+{
+	// There is no vectored equivalent of ReadProcessMemory()
+	for (size_t i = 0; i < count; ++i) {
+		requests[i].success = ReadRemote(requests[i].addr, requests[i].buf, requests[i].size);
+	}
+}
+
+bool GameProcess::WriteRemote(gameAddr addr, const void* buf, size_t writeSize)
+{
+	return WriteProcessMemory(m_processHandle, (LPVOID)addr, (LPCVOID)buf, writeSize, nullptr) != 0;
+}
+
 bool GameProcess::LoadGameMainModule(const char* processName)
 {
 	std::vector<moduleEntry> modules = GetModuleList();
@@ -217,8 +240,155 @@ bool GameProcess::LoadGameMainModule(const char* processName)
 	return mainModule.address != -1;
 }
 
+bool GameProcess::ReadMemory(gameAddr addr, void* buf, size_t readSize) const
+{
+	if (m_snapshot != nullptr) {
+		return m_snapshot->Read(addr, buf, readSize);
+	}
+
+	bool success = false;
+	if (m_readCacheDepth > 0 && readSize <= GAME_READ_CACHE_MAX_READ) {
+		success = ReadCached(addr, buf, readSize);
+	}
+	if (!success) {
+		success = ReadRemote(addr, buf, readSize);
+	}
+
+	if (success && m_recording != nullptr) {
+		m_recording->Record(addr, buf, readSize);
+	}
+	return success;
+}
+
+bool GameProcess::WriteMemory(gameAddr addr, const void* buf, size_t writeSize)
+{
+	if (m_snapshot != nullptr) {
+		m_snapshot->Record(addr, buf, writeSize);
+		return true;
+	}
+
+	InvalidateCachedPages(addr, writeSize);
+	return WriteRemote(addr, buf, writeSize);
+}
+
+bool GameProcess::ReadCached(gameAddr addr, void* buf, size_t readSize) const
+{
+	const gameAddr pageMask = ~(gameAddr)(GAME_READ_CACHE_PAGE_SIZE - 1);
+	gameAddr endAddr = addr + readSize;
+
+	for (gameAddr page = addr & pageMask; page < endAddr; page += GAME_READ_CACHE_PAGE_SIZE)
+	{
+		gameAddr copyStart = page < addr ? addr : page;
+		gameAddr copyEnd = page + GAME_READ_CACHE_PAGE_SIZE < endAddr ? page + GAME_READ_CACHE_PAGE_SIZE : endAddr;
+		Byte* copyDest = (Byte*)buf + (copyStart - addr);
+
+		uint64_t generation;
+		{
+			std::lock_guard<std::mutex> lock(m_readCacheMutex);
+			auto it = m_cachedPages.find(page);
+			if (it != m_cachedPages.end()) {
+				memcpy(copyDest, it->second.data() + (copyStart - page), copyEnd - copyStart);
+				continue;
+			}
+			generation = m_readCacheGeneration;
+		}
+
+		// Read the page without holding the lock so that concurrent extractions don't wait on each other's reads
+		std::array<Byte, GAME_READ_CACHE_PAGE_SIZE> pageData;
+		if (!ReadRemote(page, pageData.data(), GAME_READ_CACHE_PAGE_SIZE)) {
+			return false;
+		}
+		memcpy(copyDest, pageData.data() + (copyStart - page), copyEnd - copyStart);
+
+		std::lock_guard<std::mutex> lock(m_readCacheMutex);
+		if (generation != m_readCacheGeneration) {
+			// The page may have been written to while we were reading it
+			continue;
+		}
+		if (m_cachedPages.size() >= GAME_READ_CACHE_MAX_PAGES) {
+			// Areas already copied in [buf] don't need their pages anymore, we can start over
+			m_cachedPages.clear();
+		}
+		m_cachedPages.try_emplace(page, pageData);
+	}
+
+	return true;
+}
+
+void GameProcess::InvalidateCachedPages(gameAddr addr, size_t size)
+{
+	std::lock_guard<std::mutex> lock(m_readCacheMutex);
+
+	++m_readCacheGeneration;
+
+	if (m_cachedPages.size() == 0 || size == 0) {
+		return;
+	}
+
+	const gameAddr pageMask = ~(gameAddr)(GAME_READ_CACHE_PAGE_SIZE - 1);
+	for (gameAddr page = addr & pageMask; page < addr + size; page += GAME_READ_CACHE_PAGE_SIZE) {
+		m_cachedPages.erase(page);
+	}
+}
+
 // -- Public methods -- //
 
+bool GameProcess::AttachToSnapshot(GameProcessSnapshot* snapshot)
+{
+	if (status == GameProcessErrcode_PROC_ATTACHED) {
+		delete snapshot;
+		return false;
+	}
+
+	allocatedMemory.clear();
+	m_toFree.clear();
+
+	m_snapshot = snapshot;
+	mainModule = snapshot->mainModule;
+	status = GameProcessErrcode_PROC_ATTACHED;
+	return true;
+}
+
+void GameProcess::StartRecording()
+{
+	delete m_recording;
+
+	auto recording = new GameProcessSnapshot;
+	recording->mainModule = mainModule;
+	recording->modules = GetModuleList();
+	m_recording = recording;
+}
+
+GameProcessSnapshot* GameProcess::StopRecording()
+{
+	GameProcessSnapshot* recording = m_recording;
+	m_recording = nullptr;
+
+	if (recording != nullptr) {
+		DEBUG_LOG("Stopped recording, %llu bytes recorded\n", recording->GetRecordedSize());
+	}
+	return recording;
+}
+
+void GameProcess::BeginReadCache()
+{
+	++m_readCacheDepth;
+}
+
+void GameProcess::EndReadCache()
+{
+	if (--m_readCacheDepth == 0) {
+		InvalidateReadCache();
+	}
+}
+
+void GameProcess::InvalidateReadCache()
+{
+	std::lock_guard<std::mutex> lock(m_readCacheMutex);
+	++m_readCacheGeneration;
+	m_cachedPages.clear();
+}
+
 bool GameProcess::Attach(const char* processName, DWORD processExtraFlags)
 {
 	if (status == GameProcessErrcode_PROC_ATTACHED) {
@@ -237,6 +407,15 @@ void GameProcess::Detach()
 		CloseHandle(m_processHandle);
 		m_processHandle = nullptr;
 	}
+	if (m_snapshot != nullptr) {
+		delete m_snapshot;
+		m_snapshot = nullptr;
+	}
+	InvalidateReadCache();
+	{
+		std::lock_guard lock(m_aobMutex);
+		m_aobResults.clear();
+	}
 	mainModule.address = -1;
 	status = GameProcessErrcode_PROC_NOT_ATTACHED;
 }
@@ -248,10 +427,15 @@ bool GameProcess::IsAttached() const
 
 bool GameProcess::CheckRunning()
 {
+	if (m_snapshot != nullptr) {
+		// Snapshots never exit
+		return true;
+	}
+
 	if (m_processHandle != nullptr)
 	{
 		int32_t value = 0;
-		if (ReadProcessMemory(m_processHandle, (LPCVOID)mainModule.address, (LPVOID)&value, 4, nullptr) == 0)
+		if (!ReadRemote(mainModule.address, &value, 4))
 		{
 			DEBUG_LOG("! CheckRunning() failed: Process not running anymore !\n");
 			Detach();
@@ -287,125 +471,160 @@ void GameProcess::FreeOldGameMemory(bool instant)
 int8_t GameProcess::readInt8(gameAddr addr) const
 {
 	int8_t value{ -1 };
-	ReadProcessMemory(m_processHandle, (LPCVOID)addr, (LPVOID)&value, 1, nullptr);
+	ReadMemory(addr, &value, 1);
 	return value;
 }
 
 int16_t GameProcess::readInt16(gameAddr addr) const
 {
 	int16_t value{ -1 };
-	ReadProcessMemory(m_processHandle, (LPCVOID)addr, (LPVOID)&value, 2, nullptr);
+	ReadMemory(addr, &value, 2);
 	return value;
 }
 
 int32_t GameProcess::readInt32(gameAddr addr) const
 {
 	int32_t value{ -1 };
-	ReadProcessMemory(m_processHandle, (LPCVOID)addr, (LPVOID)&value, 4, nullptr);
+	ReadMemory(addr, &value, 4);
 	return value;
 }
 
 int64_t GameProcess::readInt64(gameAddr addr) const
 {
 	int64_t value{ -1 };
-	ReadProcessMemory(m_processHandle, (LPCVOID)addr, (LPVOID)&value, 8, nullptr);
+	ReadMemory(addr, &value, 8);
 	return value;
 }
 
 uint8_t GameProcess::readUInt8(gameAddr addr) const
 {
 	uint8_t value{ (uint8_t)-1};
-	ReadProcessMemory(m_processHandle, (LPCVOID)addr, (LPVOID)&value, 1, nullptr);
+	ReadMemory(addr, &value, 1);
 	return value;
 }
 
 uint16_t GameProcess::readUInt16(gameAddr addr) const
 {
 	uint16_t value{ (uint16_t)-1};
-	ReadProcessMemory(m_processHandle, (LPCVOID)addr, (LPVOID)&value, 2, nullptr);
+	ReadMemory(addr, &value, 2);
 	return value;
 }
 
 uint32_t GameProcess::readUInt32(gameAddr addr) const
 {
 	uint32_t value{ (uint32_t)-1};
-	ReadProcessMemory(m_processHandle, (LPCVOID)addr, (LPVOID)&value, 4, nullptr);
+	ReadMemory(addr, &value, 4);
 	return value;
 }
 
 uint64_t GameProcess::readUInt64(gameAddr addr) const
 {
 	uint64_t value{ (uint64_t)- 1};
-	ReadProcessMemory(m_processHandle, (LPCVOID)addr, (LPVOID)&value, 8, nullptr);
+	ReadMemory(addr, &value, 8);
 	return value;
 }
 
 float GameProcess::readFloat(gameAddr addr) const
 {
 	float value{ -1 };
-	ReadProcessMemory(m_processHandle, (LPCVOID)addr, (LPVOID)&value, 4, nullptr);
+	ReadMemory(addr, &value, 4);
 	return value;
 }
 
 void GameProcess::readBytes(gameAddr addr, void* buf, size_t readSize) const
 {
-	ReadProcessMemory(m_processHandle, (LPCVOID)addr, (LPVOID)buf, readSize, nullptr);
+	ReadMemory(addr, buf, readSize);
+}
+
+bool GameProcess::readBatch(GameProcessReadRequest* requests, size_t count) const
+{
+	if (m_snapshot != nullptr || m_readCacheDepth > 0)
+	{
+		// Reads that don't necessarily reach the process, no need to group them
+		for (size_t i = 0; i < count; ++i) {
+			requests[i].success = ReadMemory(requests[i].addr, requests[i].buf, requests[i].size);
+		}
+	}
+	else
+	{
+		ReadRemoteBatch(requests, count);
+		if (m_recording != nullptr)
+		{
+			for (size_t i = 0; i < count; ++i) {
+				if (requests[i].success) {
+					m_recording->Record(requests[i].addr, requests[i].buf, requests[i].size);
+				}
+			}
+		}
+	}
+
+	for (size_t i = 0; i < count; ++i) {
+		if (!requests[i].success) {
+			return false;
+		}
+	}
+	return true;
 }
 
 
 void GameProcess::writeInt8(gameAddr addr, int8_t value)
 {
-	WriteProcessMemory(m_processHandle, (LPVOID)addr, (LPCVOID)&value, 1, nullptr);
+	WriteMemory(addr, &value, 1);
 }
 
 void  GameProcess::writeInt16(gameAddr addr, int16_t value)
 {
-	WriteProcessMemory(m_processHandle, (LPVOID)addr, (LPCVOID)&value, 2, nullptr);
+	WriteMemory(addr, &value, 2);
 }
 
 void  GameProcess::writeInt32(gameAddr addr, int32_t value)
 {
-	WriteProcessMemory(m_processHandle, (LPVOID)addr, (LPCVOID)&value, 4, nullptr);
+	WriteMemory(addr, &value, 4);
 }
 
 void  GameProcess::writeInt64(gameAddr addr, int64_t value)
 {
-	WriteProcessMemory(m_processHandle, (LPVOID)addr, (LPCVOID)&value, 8, nullptr);
+	WriteMemory(addr, &value, 8);
 }
 
 void GameProcess::writeUInt8(gameAddr addr, uint8_t value)
 {
-	WriteProcessMemory(m_processHandle, (LPVOID)addr, (LPCVOID)&value, 1, nullptr);
+	WriteMemory(addr, &value, 1);
 }
 
 void  GameProcess::writeUInt16(gameAddr addr, uint16_t value)
 {
-	WriteProcessMemory(m_processHandle, (LPVOID)addr, (LPCVOID)&value, 2, nullptr);
+	WriteMemory(addr, &value, 2);
 }
 
 void  GameProcess::writeUInt32(gameAddr addr, uint32_t value)
 {
-	WriteProcessMemory(m_processHandle, (LPVOID)addr, (LPCVOID)&value, 4, nullptr);
+	WriteMemory(addr, &value, 4);
 }
 
 void  GameProcess::writeUInt64(gameAddr addr, uint64_t value)
 {
-	WriteProcessMemory(m_processHandle, (LPVOID)addr, (LPCVOID)&value, 8, nullptr);
+	WriteMemory(addr, &value, 8);
 }
 
 void  GameProcess::writeFloat(gameAddr addr, float value)
 {
-	WriteProcessMemory(m_processHandle, (LPVOID)addr, (LPCVOID)&value, 4, nullptr);
+	WriteMemory(addr, &value, 4);
 }
 
 void  GameProcess::writeBytes(gameAddr addr, void* buf, size_t bufSize)
 {
-	WriteProcessMemory(m_processHandle, (LPVOID)addr, (LPCVOID)buf, bufSize, nullptr);
+	WriteMemory(addr, buf, bufSize);
 }
 
 
 gameAddr GameProcess::allocateMem(size_t amount, bool executable)
 {
+	if (m_snapshot != nullptr) {
+		DEBUG_LOG("Allocation failure: can't allocate memory in a snapshot\n");
+		return 0;
+	}
+
 	auto allocFlag = executable ? PAGE_EXECUTE_READWRITE : PAGE_READWRITE;
 	gameAddr allocatedBlock = (gameAddr)VirtualAllocEx(m_processHandle, nullptr, amount, MEM_COMMIT | MEM_RESERVE, allocFlag);
 	if (allocatedBlock != 0) {
@@ -672,67 +891,187 @@ bool GameProcess::InjectDll(const wchar_t* fullpath)
 }
 
 
-gameAddr GameProcess::AOBScan(unsigned int startingBytes, const char* bytesString)
+uint32_t GameProcess::GetExecutableHash() const
 {
-	// This has not been tested
-	const unsigned int bufsize = 8192; // Must be a multiple of 4 at the very least
-	const unsigned int readBufUpTo = bufsize - 4;
-	unsigned char buffer[bufsize];
+	// The PE headers contain the link timestamp, the checksum and the section sizes of the executable
+	Byte headers[4096];
+	if (!ReadMemory(mainModule.address, headers, sizeof(headers))) {
+		return 0;
+	}
 
-	unsigned int bytesString_len = Helpers::get_memory_string_length(bytesString);
+	uint32_t hash = Helpers::crc32_update(0, headers, sizeof(headers));
+	return Helpers::crc32_update(hash, &mainModule.size, sizeof(mainModule.size));
+}
+
+std::vector<gameAddr> GameProcess::AOBScan(const std::vector<const char*>& bytesStrings)
+{
+	std::vector<gameAddr> results(bytesStrings.size(), 0);
+	std::vector<AOBPattern> patterns(bytesStrings.size());
+	std::vector<uint64_t> offsets(bytesStrings.size(), AOB_NOT_FOUND);
+	size_t remaining = 0;
 
-	// Todo: limit to a single module. We know what we're looking for.
-	for (auto& module : GetModuleList())
+	for (size_t i = 0; i < bytesStrings.size(); ++i)
 	{
-		gameAddr startAddr = module.address;
-		gameAddr endAddr = startAddr + (module.size / bytesString_len) * bytesString_len;
-		memset(buffer, 0, bufsize);
-		DEBUG_LOG("%s\n", module.name.c_str());
-		while (startAddr < endAddr)
+		if (!AOBScanUtils::ParsePattern(bytesStrings[i], patterns[i])) {
+			DEBUG_ERR("AOBScan: invalid pattern '%s'", bytesStrings[i]);
+			// Invalid patterns are marked as found so that they're not looked for
+			offsets[i] = 0;
+		}
+	}
+
+	{
+		// Patterns already looked for since attaching, found or not, are not looked for again
+		std::lock_guard lock(m_aobMutex);
+		for (size_t i = 0; i < patterns.size(); ++i)
+		{
+			if (offsets[i] != AOB_NOT_FOUND) continue;
+			auto previousResult = m_aobResults.find(patterns[i].hash);
+			if (previousResult != m_aobResults.end()) {
+				results[i] = previousResult->second;
+				offsets[i] = 0;
+			}
+		}
+	}
+
+	std::vector<bool> lookedFor(patterns.size());
+	bool anyLookedFor = false;
+	for (size_t i = 0; i < patterns.size(); ++i) {
+		lookedFor[i] = offsets[i] == AOB_NOT_FOUND;
+		anyLookedFor |= lookedFor[i];
+	}
+
+	uint32_t exeHash = 0;
+	std::map<uint32_t, uint64_t> cachedOffsets;
+	if (anyLookedFor) {
+		exeHash = GetExecutableHash();
+		cachedOffsets = AOBScanUtils::LoadCachedResults(exeHash);
+	}
+
+	for (size_t i = 0; i < patterns.size(); ++i)
+	{
+		if (!lookedFor[i]) continue;
+		auto& pattern = patterns[i];
+
+		// Results from a previous scan of this executable are checked before being trusted
+		auto cachedOffset = cachedOffsets.find(pattern.hash);
+		if (cachedOffset != cachedOffsets.end())
 		{
-			if (!ReadProcessMemory(m_processHandle, (LPCVOID)startAddr, (LPVOID)buffer, bufsize, nullptr))
+			std::vector<Byte> buf(pattern.bytes.size());
+			if (ReadMemory(mainModule.address + cachedOffset->second, buf.data(), buf.size()) && AOBScanUtils::MatchesAt(buf.data(), pattern))
 			{
-				DEBUG_LOG("ReadprocessMemory error\n");
-				break;
+				results[i] = mainModule.address + cachedOffset->second;
+				offsets[i] = cachedOffset->second;
+				continue;
+			}
+		}
+
+		++remaining;
+	}
+
+	// Snapshots only contain what was read during the recording, there is no module to scan
+	if (remaining > 0 && m_snapshot == nullptr) {
+		size_t scanned = ScanMainModule(patterns, offsets, remaining);
+		for (size_t i = 0; i < patterns.size(); ++i)
+		{
+			if (lookedFor[i] && results[i] == 0 && offsets[i] != AOB_NOT_FOUND) {
+				results[i] = mainModule.address + offsets[i];
+				cachedOffsets[patterns[i].hash] = offsets[i];
+			}
+		}
+		if (scanned > 0) {
+			AOBScanUtils::SaveCachedResults(exeHash, cachedOffsets);
+		}
+		DEBUG_LOG("AOBScan: %llu patterns found by scanning, %llu not found\n", (uint64_t)scanned, (uint64_t)(remaining - scanned));
+	}
+
+	{
+		std::lock_guard lock(m_aobMutex);
+		for (size_t i = 0; i < patterns.size(); ++i) {
+			if (lookedFor[i]) {
+				m_aobResults[patterns[i].hash] = results[i];
+			}
+		}
+	}
+
+	return results;
+}
+
+size_t GameProcess::ScanMainModule(const std::vector<AOBPattern>& patterns, std::vector<uint64_t>& offsets, size_t remaining)
+{
+	size_t maxPatternSize = 0;
+	for (size_t i = 0; i < patterns.size(); ++i) {
+		if (offsets[i] == AOB_NOT_FOUND && patterns[i].bytes.size() > maxPatternSize) {
+			maxPatternSize = patterns[i].bytes.size();
+		}
+	}
+	size_t scanned = 0;
+
+	// Consecutive windows overlap so that patterns crossing the end of one window are found in the next one
+	size_t windowOverlap = maxPatternSize - 1;
+	Byte* window;
+	try {
+		window = new Byte[AOB_SCAN_WINDOW_SIZE + windowOverlap];
+	}
+	catch (std::bad_alloc&) {
+		DEBUG_ERR("AOBScan: failed to allocate the scan window");
+		return 0;
+	}
+
+	std::vector<uint64_t> windowOffsets(patterns.size());
+	for (uint64_t windowStart = 0; windowStart < mainModule.size && remaining > 0; windowStart += AOB_SCAN_WINDOW_SIZE)
+	{
+		size_t windowSize = AOB_SCAN_WINDOW_SIZE + windowOverlap;
+		if (windowStart + windowSize > mainModule.size) {
+			windowSize = (size_t)(mainModule.size - windowStart);
+		}
+
+		if (!ReadMemory(mainModule.address + windowStart, window, windowSize))
+		{
+			// Some pages of the module may not be readable, read the window page by page and ignore those
+			std::vector<GameProcessReadRequest> requests;
+			for (size_t pageOffset = 0; pageOffset < windowSize; pageOffset += GAME_READ_CACHE_PAGE_SIZE)
+			{
+				requests.push_back({
+					.addr = mainModule.address + windowStart + pageOffset,
+					.buf = window + pageOffset,
+					.size = windowSize - pageOffset < GAME_READ_CACHE_PAGE_SIZE ? windowSize - pageOffset : GAME_READ_CACHE_PAGE_SIZE
+				});
 			}
+			readBatch(requests.data(), requests.size());
+			for (auto& request : requests) {
+				if (!request.success) {
+					memset(request.buf, 0, request.size);
+				}
+			}
+		}
+
+		for (size_t i = 0; i < patterns.size(); ++i) {
+			windowOffsets[i] = offsets[i] == AOB_NOT_FOUND ? AOB_NOT_FOUND : 0;
+		}
+		AOBScanUtils::FindPatterns(window, windowSize, patterns, windowOffsets);
 
-			for (unsigned int i = 0; i < readBufUpTo; ++i)
+		for (size_t i = 0; i < patterns.size(); ++i)
+		{
+			if (offsets[i] == AOB_NOT_FOUND && windowOffsets[i] != AOB_NOT_FOUND)
 			{
-				if (*(unsigned int*)&buffer[i] == startingBytes)
-				{
-					bool result;
-
-					if (bufsize - i <= bytesString_len) {
-						result = Helpers::compare_memory_string(&buffer[i], bytesString);
-					} if (endAddr - startAddr <= bytesString_len) {
-						unsigned char* tmp_buffer = new unsigned char[bytesString_len];
-						if (!ReadProcessMemory(m_processHandle, (LPCVOID)startAddr, (LPVOID)tmp_buffer, bytesString_len, nullptr))
-						{
-							DEBUG_LOG("ReadprocessMemory error\n");
-							startAddr = endAddr;
-							break;
-						}
-						result = Helpers::compare_memory_string(tmp_buffer, bytesString);
-						delete[] tmp_buffer;
-					}
-					else {
-						result = false;
-					}
-
-					if (result) {
-						return startAddr + i;
-					}
-				}	
+				offsets[i] = windowStart + windowOffsets[i];
+				--remaining;
+				++scanned;
 			}
-			startAddr += bufsize;
 		}
 	}
-	DEBUG_LOG("fin\n");
-	
-	return 0;
+
+	delete[] window;
+	return scanned;
+}
+
+gameAddr GameProcess::AOBScan(const char* bytesString)
+{
+	return AOBScan(std::vector<const char*>{ bytesString })[0];
 }
 
 GameProcess::~GameProcess()
 {
 	Detach();
+	delete m_recording;
 }
\ No newline at end of file
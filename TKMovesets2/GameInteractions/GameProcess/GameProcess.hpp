@@ -4,9 +4,19 @@
 #include <vector>
 #include <thread>
 #include <utility>
+#include <array>
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
 #include <windows.h>
 
+#include "GameProcessSnapshot.hpp"
+
 #include "GameTypes.h"
+#include "constants.h"
+
+struct AOBPattern;
 
 struct processEntry
 {
@@ -25,6 +35,16 @@ struct moduleEntry
 };
 #endif
 
+// An area to read as part of a batch, see GameProcess::readBatch()
+struct GameProcessReadRequest
+{
+	gameAddr addr;
+	void* buf;
+	size_t size;
+	// Set by the batch: true if the area was read, false if it could not be, in which case the content of [buf] is undefined
+	bool success;
+};
+
 namespace GameProcessUtils
 {
 	std::vector<processEntry> GetRunningProcessList();
@@ -69,6 +89,22 @@ private:
 	std::vector<std::pair<uint64_t, gameAddr>> m_toFree;
 	// Stores the game pid
 	DWORD m_pid;
+	// If not null, every read made on the process is also copied in there
+	GameProcessSnapshot* m_recording = nullptr;
+	// If not null, we are attached to this snapshot instead of an actual process: reads and writes go there
+	GameProcessSnapshot* m_snapshot = nullptr;
+	// Pages read from the process since the read cache was enabled, keyed by their address
+	mutable std::unordered_map<gameAddr, std::array<Byte, GAME_READ_CACHE_PAGE_SIZE>> m_cachedPages;
+	// Amount of read cache scopes currently opened, reads are only cached when above 0
+	std::atomic<int> m_readCacheDepth = 0;
+	// Protects .m_cachedPages, extractors may read from multiple threads. Never held during process reads.
+	mutable std::mutex m_readCacheMutex;
+	// Incremented whenever cached pages are invalidated, pages read from the process before that are not cached
+	uint64_t m_readCacheGeneration = 0;
+	// AOB scan results of the current attachment keyed by pattern hash, 0 for patterns that were not found
+	std::map<uint32_t, gameAddr> m_aobResults;
+	// Protects .m_aobResults
+	std::mutex m_aobMutex;
 
 	// Attach to .processName
 	GameProcessErrcode_ AttachToNamedProcess(const char* processName, DWORD processExtraFlags);
@@ -76,6 +112,24 @@ private:
 	DWORD GetGamePID(const char* processName);
 	// Load informations about the main module in .mainModule
 	bool LoadGameMainModule(const char* processName);
+
+	// Reads from the attached process, without going through the snapshot or recording logic
+	bool ReadRemote(gameAddr addr, void* buf, size_t readSize) const;
+	// Reads multiple areas from the attached process
+	void ReadRemoteBatch(GameProcessReadRequest* requests, size_t count) const;
+	// Writes to the attached process, without going through the snapshot logic
+	bool WriteRemote(gameAddr addr, const void* buf, size_t writeSize);
+	// Reads an area through the page cache, fetching the pages that are not cached yet. Returns false if any page could not be read.
+	bool ReadCached(gameAddr addr, void* buf, size_t readSize) const;
+	// Removes the cached pages overlapping with an area
+	void InvalidateCachedPages(gameAddr addr, size_t size);
+	// Reads from the process or from the snapshot we're attached to. Every read goes through here.
+	bool ReadMemory(gameAddr addr, void* buf, size_t readSize) const;
+	// Writes to the process or to the snapshot we're attached to. Every write goes through here.
+	bool WriteMemory(gameAddr addr, const void* buf, size_t writeSize);
+	// Scans the main module window by window for the patterns whose offset is AOB_NOT_FOUND, writing the offset of the ones found. Returns how many were found.
+	size_t ScanMainModule(const std::vector<AOBPattern>& patterns, std::vector<uint64_t>& offsets, size_t remaining);
+
 public:
 	~GameProcess();
 
@@ -107,6 +161,28 @@ public:
 	// Returns a list of module currently loaded in the target remote process
 	std::vector<moduleEntry> GetModuleList() const;
 
+	// -- Snapshots -- //
+
+	// Attach to a recorded snapshot instead of a live process. Takes ownership of the snapshot.
+	bool AttachToSnapshot(GameProcessSnapshot* snapshot);
+	// Starts copying everything that gets read from the process into a snapshot, along with the module list
+	void StartRecording();
+	// Stops the recording and returns the snapshot. Returns null if no recording was started. Snapshot must be freed by the caller.
+	GameProcessSnapshot* StopRecording();
+	// Returns true if attached to a snapshot instead of a live process
+	bool IsSnapshot() const { return m_snapshot != nullptr; }
+
+	// -- Read cache -- //
+
+	// Starts caching reads page by page until the matching EndReadCache(), so that many small reads only cost one read per page
+	// Scopes can be nested, the cache is dropped when the outermost one ends. Writes made through this class keep the cache up to date, but changes made by the game itself are not seen.
+	// Only use around passes where the memory being read is not expected to change, such as an extraction. See GameProcessReadCacheScope.
+	void BeginReadCache();
+	// Ends a scope started by BeginReadCache()
+	void EndReadCache();
+	// Drops every cached page, forcing the next reads to hit the process again
+	void InvalidateReadCache();
+
 	// Returns a list of window names for the windows attached to the process
 	std::vector<std::string> GetWindowsList() const;
 
@@ -133,19 +209,22 @@ public:
 	float   readFloat(gameAddr addr) const;
 	// Reads [readSize] amounts of bytes from the game and write them to the provided buffer
 	void    readBytes(gameAddr addr, void* buf, size_t readSize) const;
+	// Reads multiple independent areas at once, setting the .success of each request. Returns true if every area was read.
+	// Goes straight to the process when there is no snapshot or read cache to go through.
+	bool    readBatch(GameProcessReadRequest* requests, size_t count) const;
 
 	// Writes a value to the remote process's memory, adapting to the value type's size
 	template<typename T>
 	void write(gameAddr addr, T value)
 	{
-		WriteProcessMemory(m_processHandle, (LPVOID)addr, (LPCVOID)&value, sizeof(T), nullptr);
+		WriteMemory(addr, &value, sizeof(T));
 	};
 	// Reads a value in the remote process's memory, adapting to the expected return value type's size
 	template<typename T>
 	T read(gameAddr addr) const
 	{
 		T value{ (T)-1 };
-		ReadProcessMemory(m_processHandle, (LPCVOID)addr, (LPVOID)&value, sizeof(T), nullptr);
+		ReadMemory(addr, &value, sizeof(T));
 		return value;
 	};
 
@@ -184,6 +263,22 @@ public:
 	// Create a thread in the remote process. Can wait for the end of the thread and receive the thread exit code
 	GameProcessThreadCreation_ createRemoteThread(gameAddr startAddress, uint64_t argument=0, bool waitEnd=false, int32_t* exitCodeThread=nullptr);
 
-	// Scans the main module for an AOB
-	gameAddr AOBScan(unsigned int startingBytes, const char* bytesString);
+	// Returns a hash identifying the executable of the main module, which changes whenever the game is updated
+	uint32_t GetExecutableHash() const;
+	// Scans the main module for multiple AOBs such as '00 F7 E1 45 0? 45 ?? ?? 89' in a single pass, returning the address of each one (or 0 if not found)
+	// Results are saved per executable hash, so the module only has to be scanned again when the game gets updated
+	// Results are also kept until detaching, so that a pattern is only ever looked for once per attachment
+	std::vector<gameAddr> AOBScan(const std::vector<const char*>& bytesStrings);
+	// Scans the main module for an AOB, returns 0 if not found
+	gameAddr AOBScan(const char* bytesString);
+};
+
+// Enables the read cache of a process for as long as the object lives
+class GameProcessReadCacheScope
+{
+private:
+	GameProcess& m_process;
+public:
+	GameProcessReadCacheScope(GameProcess& process) : m_process(process) { m_process.BeginReadCache(); }
+	~GameProcessReadCacheScope() { m_process.EndReadCache(); }
 };
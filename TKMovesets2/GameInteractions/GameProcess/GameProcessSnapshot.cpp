@@ -0,0 +1,270 @@
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+#include "GameProcessSnapshot.hpp"
+#include "Helpers.hpp"
+
+#include "constants.h"
+
+// Increase whenever the file format changes
+#define SNAPSHOT_FILE_VERSION (2)
+// Longer module names or paths indicate a bad file
+#define SNAPSHOT_MAX_STRING_LENGTH (4096)
+
+// -- Static helpers -- //
+
+// Strings are written as their length followed by their UTF-8 bytes, the same on every platform
+static void WriteString(std::ofstream& file, const std::string& str)
+{
+	uint32_t length = (uint32_t)str.size();
+	file.write((char*)&length, sizeof(length));
+	file.write(str.data(), length);
+}
+
+static bool ReadString(std::ifstream& file, std::string& str)
+{
+	uint32_t length = 0;
+	file.read((char*)&length, sizeof(length));
+	if (file.fail() || length > SNAPSHOT_MAX_STRING_LENGTH) {
+		return false;
+	}
+	str.resize(length);
+	file.read(str.data(), length);
+	return !file.fail();
+}
+
+static void WriteModule(std::ofstream& file, const moduleEntry& module)
+{
+	file.write((char*)&module.address, sizeof(module.address));
+	file.write((char*)&module.size, sizeof(module.size));
+	WriteString(file, module.name);
+	// wchar_t's size depends on the compiler, paths are stored as UTF-8 to keep the file layout fixed
+	WriteString(file, Helpers::to_utf8(module.path));
+}
+
+static bool ReadModule(std::ifstream& file, moduleEntry& module)
+{
+	file.read((char*)&module.address, sizeof(module.address));
+	file.read((char*)&module.size, sizeof(module.size));
+
+	std::string path;
+	if (file.fail() || !ReadString(file, module.name) || !ReadString(file, path)) {
+		return false;
+	}
+
+	try {
+		module.path = Helpers::to_unicode(path);
+	}
+	catch (std::range_error&) {
+		DEBUG_ERR("Snapshot: invalid module path '%s'", path.c_str());
+		return false;
+	}
+	return true;
+}
+
+// -- Public methods -- //
+
+void GameProcessSnapshot::Record(gameAddr addr, const void* buf, size_t size)
+{
+	if (size == 0) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	gameAddr start = addr;
+	gameAddr end = addr + size;
+
+	// Find the first range overlapping or touching the new one
+	auto first = m_ranges.upper_bound(addr);
+	if (first != m_ranges.begin())
+	{
+		auto prev = std::prev(first);
+		if (prev->first + prev->second.size() >= addr) {
+			first = prev;
+		}
+	}
+
+	// Common case: already recorded area being read again
+	if (first != m_ranges.end() && first->first <= start && first->first + first->second.size() >= end) {
+		memcpy(first->second.data() + (start - first->first), buf, size);
+		return;
+	}
+
+	// Find every range to merge with the new one
+	auto last = first;
+	gameAddr mergedStart = start;
+	gameAddr mergedEnd = end;
+	while (last != m_ranges.end() && last->first <= end)
+	{
+		mergedStart = std::min(mergedStart, last->first);
+		mergedEnd = std::max(mergedEnd, (gameAddr)(last->first + last->second.size()));
+		++last;
+	}
+
+	std::vector<Byte> merged(mergedEnd - mergedStart);
+	for (auto it = first; it != last; ++it) {
+		memcpy(merged.data() + (it->first - mergedStart), it->second.data(), it->second.size());
+	}
+	memcpy(merged.data() + (start - mergedStart), buf, size);
+
+	m_ranges.erase(first, last);
+	m_ranges.emplace(mergedStart, std::move(merged));
+}
+
+bool GameProcessSnapshot::Read(gameAddr addr, void* buf, size_t size) const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	auto it = m_ranges.upper_bound(addr);
+	if (it == m_ranges.begin()) {
+		return false;
+	}
+	--it;
+
+	// Ranges are merged, so the area has to be entirely within a single one
+	if (addr + size > it->first + it->second.size()) {
+		return false;
+	}
+
+	memcpy(buf, it->second.data() + (addr - it->first), size);
+	return true;
+}
+
+uint64_t GameProcessSnapshot::GetRecordedSize() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	uint64_t size = 0;
+	for (auto& [addr, range] : m_ranges) {
+		size += range.size();
+	}
+	return size;
+}
+
+bool GameProcessSnapshot::Save(const std::wstring& filename) const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	std::ofstream file(std::filesystem::path(filename), std::ios::binary);
+	if (file.fail()) {
+		DEBUG_ERR("Snapshot: failed to open '%S' for writing", filename.c_str());
+		return false;
+	}
+
+	uint32_t version = SNAPSHOT_FILE_VERSION;
+	uint32_t moduleCount = (uint32_t)modules.size();
+	uint64_t rangeCount = m_ranges.size();
+
+	file.write("TKMS", 4);
+	file.write((char*)&version, sizeof(version));
+	file.write((char*)&gameId, sizeof(gameId));
+	file.write((char*)&minorVersion, sizeof(minorVersion));
+	file.write((char*)&baseAddr, sizeof(baseAddr));
+	file.write((char*)&playerAddress, sizeof(playerAddress));
+	file.write((char*)&extractSettings, sizeof(extractSettings));
+
+	WriteModule(file, mainModule);
+	file.write((char*)&moduleCount, sizeof(moduleCount));
+	for (auto& module : modules) {
+		WriteModule(file, module);
+	}
+
+	file.write((char*)&rangeCount, sizeof(rangeCount));
+	for (auto& [addr, range] : m_ranges)
+	{
+		uint64_t rangeSize = range.size();
+		file.write((char*)&addr, sizeof(addr));
+		file.write((char*)&rangeSize, sizeof(rangeSize));
+		file.write((char*)range.data(), rangeSize);
+	}
+
+	if (file.fail()) {
+		DEBUG_ERR("Snapshot: failed to write '%S'", filename.c_str());
+		return false;
+	}
+
+	DEBUG_LOG("Snapshot: saved %llu ranges to '%S'\n", rangeCount, filename.c_str());
+	return true;
+}
+
+bool GameProcessSnapshot::Load(const std::wstring& filename)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	std::ifstream file(std::filesystem::path(filename), std::ios::binary);
+	if (file.fail()) {
+		DEBUG_ERR("Snapshot: failed to open '%S'", filename.c_str());
+		return false;
+	}
+
+	char signature[4];
+	uint32_t version;
+	file.read(signature, sizeof(signature));
+	file.read((char*)&version, sizeof(version));
+
+	if (file.fail() || strncmp(signature, "TKMS", 4) != 0 || version != SNAPSHOT_FILE_VERSION) {
+		DEBUG_ERR("Snapshot: '%S' is not a snapshot file or was made by another version", filename.c_str());
+		return false;
+	}
+
+	file.read((char*)&gameId, sizeof(gameId));
+	file.read((char*)&minorVersion, sizeof(minorVersion));
+	file.read((char*)&baseAddr, sizeof(baseAddr));
+	file.read((char*)&playerAddress, sizeof(playerAddress));
+	file.read((char*)&extractSettings, sizeof(extractSettings));
+
+	if (!ReadModule(file, mainModule)) {
+		return false;
+	}
+
+	uint32_t moduleCount;
+	file.read((char*)&moduleCount, sizeof(moduleCount));
+	modules.clear();
+	for (uint32_t i = 0; i < moduleCount && !file.fail(); ++i)
+	{
+		moduleEntry module;
+		if (!ReadModule(file, module)) {
+			return false;
+		}
+		modules.push_back(module);
+	}
+
+	uint64_t rangeCount;
+	file.read((char*)&rangeCount, sizeof(rangeCount));
+	m_ranges.clear();
+
+	try {
+		for (uint64_t i = 0; i < rangeCount && !file.fail(); ++i)
+		{
+			gameAddr addr;
+			uint64_t rangeSize;
+			file.read((char*)&addr, sizeof(addr));
+			file.read((char*)&rangeSize, sizeof(rangeSize));
+			if (file.fail()) {
+				break;
+			}
+
+			std::vector<Byte> range(rangeSize);
+			file.read((char*)range.data(), rangeSize);
+			m_ranges.emplace(addr, std::move(range));
+		}
+	}
+	catch (std::bad_alloc&) {
+		DEBUG_ERR("Snapshot: allocation error while loading '%S'", filename.c_str());
+		m_ranges.clear();
+		return false;
+	}
+
+	if (file.fail()) {
+		DEBUG_ERR("Snapshot: '%S' is truncated", filename.c_str());
+		m_ranges.clear();
+		return false;
+	}
+
+	DEBUG_LOG("Snapshot: loaded %llu ranges from '%S'\n", rangeCount, filename.c_str());
+	return true;
+}
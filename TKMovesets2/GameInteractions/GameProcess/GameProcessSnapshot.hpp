@@ -0,0 +1,59 @@
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "GameTypes.h"
+
+#ifndef MODULE_ENTRY_DEF
+#define MODULE_ENTRY_DEF
+struct moduleEntry
+{
+	uint64_t address;
+	std::string name;
+	std::wstring path;
+	uint64_t size;
+};
+#endif
+
+// Copy of the parts of a process's memory that were read while recording, along with its module list
+// Can be saved to a file and then used in place of the actual process (see GameProcess::AttachToSnapshot()), allowing extractions to be replayed without the game
+class GameProcessSnapshot
+{
+private:
+	// Recorded memory ranges, keyed by their starting address. Overlapping and adjacent ranges are merged together.
+	std::map<gameAddr, std::vector<Byte>> m_ranges;
+	// Recording can happen from multiple threads
+	mutable std::mutex m_mutex;
+
+public:
+	// Main module of the process at the time of the recording
+	moduleEntry mainModule{ .address = (uint64_t)-1 };
+	// Modules of the process at the time of the recording
+	std::vector<moduleEntry> modules;
+
+	// -- Informations about what was recorded, used when replaying -- //
+
+	// Game the recording was made on
+	uint16_t gameId = 0;
+	uint16_t minorVersion = 0;
+	// Base address that GameData had during the recording
+	uint64_t baseAddr = 0;
+	// Player address and settings the recorded extraction was made with
+	gameAddr playerAddress = 0;
+	uint64_t extractSettings = 0;
+
+	// Stores a copy of a memory area, overwriting what might already be stored there
+	void Record(gameAddr addr, const void* buf, size_t size);
+	// Reads a memory area from the recorded ranges. Returns false without touching [buf] if any part of the area was not recorded.
+	bool Read(gameAddr addr, void* buf, size_t size) const;
+	// Returns the amount of bytes recorded
+	uint64_t GetRecordedSize() const;
+
+	// Saves the snapshot to a file
+	bool Save(const std::wstring& filename) const;
+	// Loads a snapshot from a file
+	bool Load(const std::wstring& filename);
+};
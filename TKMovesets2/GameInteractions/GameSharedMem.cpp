@@ -111,6 +111,7 @@ void GameSharedMem::QueueCharacterImportation(movesetInfo* moveset, unsigned int
 		.settings = settings,
 		.playerId = playerId
 	});
+	WakeThread();
 }
 
 bool GameSharedMem::IsBusy() const
@@ -121,12 +122,14 @@ bool GameSharedMem::IsBusy() const
 void GameSharedMem::InjectDll()
 {
 	isInjecting = true;
+	WakeThread();
 }
 
 void GameSharedMem::StopThreadAndCleanup()
 {
 	// Order thread to stop
 	m_threadStarted = false;
+	WakeThread();
 	m_t.join();
 
 	if (m_sharedMemHandler != nullptr) {
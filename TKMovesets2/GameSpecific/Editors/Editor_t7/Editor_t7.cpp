@@ -284,6 +284,7 @@ bool EditorT7::LoadMoveset(Byte* t_moveset, uint64_t t_movesetSize)
 		}
 	}
 
+	m_blockCrc32Cache.clear();
 	LoadMovesetPtr(t_moveset, t_movesetSize);
 
 	if ((m_header->flags & MovesetFlags_MovesetModified) == 0) {
@@ -804,6 +805,7 @@ std::string EditorT7::ImportAnimation(const wchar_t* filepath, int moveid)
 	// Assign new moveset
 	free(m_moveset);
 	LoadMovesetPtr(newMoveset, newMovesetSize);
+	m_blockCrc32Cache.erase(TKMovesetHeaderBlocks_Animation);
 
 	auto old_anim_addr = m_iterators.moves[moveid]->anim_addr;
 	auto old_anim_name_addr = m_iterators.moves[moveid]->anim_name_addr;
@@ -838,14 +840,36 @@ uint32_t EditorT7::CalculateCRC32()
 		{m_movesetData + m_offsets->tableBlock, m_offsets->motalistsBlock - m_offsets->tableBlock },
 		{m_movesetData + m_offsets->motalistsBlock, m_offsets->nameBlock - m_offsets->motalistsBlock },
 		{m_movesetData + m_offsets->movesetBlock, m_offsets->animationBlock - m_offsets->movesetBlock },
-		{m_movesetData + m_offsets->animationBlock, m_offsets->motaBlock - m_offsets->animationBlock },
-		{m_movesetData + m_offsets->motaBlock, m_offsets->movelistBlock - m_offsets->motaBlock },
 	};
 
 	// Because the editor might make corrections to the moveset right as it loads it,
 	// ... it is likely the CRC32 will be different from extraction
 	// That isn't that big of a problem
-	return Helpers::CalculateCrc32(hashedFileBlocks);
+	uint32_t crc32 = Helpers::CalculateCrc32(hashedFileBlocks);
+
+	// Animation & mota blocks make up most of the moveset but rarely change: only hash them again if needed
+	const std::pair<TKMovesetHeaderBlocks_, uint64_t> cachedBlocks[] = {
+		{TKMovesetHeaderBlocks_Animation, m_offsets->motaBlock - m_offsets->animationBlock },
+		{TKMovesetHeaderBlocks_Mota, m_offsets->movelistBlock - m_offsets->motaBlock },
+	};
+
+	for (auto& [block, blockSize] : cachedBlocks)
+	{
+		auto cachedCrc32 = m_blockCrc32Cache.find(block);
+		uint32_t blockCrc32;
+
+		if (cachedCrc32 != m_blockCrc32Cache.end() && cachedCrc32->second.first == blockSize) {
+			blockCrc32 = cachedCrc32->second.second;
+		}
+		else {
+			blockCrc32 = Helpers::CalculateCrc32(m_offsets->GetBlock(block, m_movesetData), blockSize);
+			m_blockCrc32Cache[block] = { blockSize, blockCrc32 };
+		}
+
+		crc32 = Helpers::crc32_combine(crc32, blockCrc32, blockSize);
+	}
+
+	return crc32;
 }
 
 void EditorT7::SetSharedMemHandler(Online** sharedMemHandler)
@@ -55,6 +55,8 @@ private:
 	} m_iterators;
 	// Used to execute extra properties if handled by the game
 	OnlineT7** m_sharedMemHandler = nullptr;
+	// Cached CRC32 of the animation & mota blocks along with the block size, invalidated when animations are imported or deleted
+	std::map<TKMovesetHeaderBlocks_, std::pair<uint64_t, uint32_t>> m_blockCrc32Cache;
 
 
 	// Extra iterators setup
@@ -335,6 +335,7 @@ void EditorT7::DeleteAnimation(uint64_t anim_offset)
 	// Assign new moveset
 	free(m_moveset);
 	LoadMovesetPtr(newMoveset, newMovesetSize);
+	m_blockCrc32Cache.erase(TKMovesetHeaderBlocks_Animation);
 }
 
 void EditorT7::DeleteNameBlockString(uint64_t string_offset)
@@ -3,9 +3,13 @@
 #include <cstdlib>
 #include <windows.h>
 #include <filesystem>
+#include <mutex>
+#include <set>
+#include <thread>
 
 #include "Helpers.hpp"
 #include "Extractor.hpp"
+#include "Compression.hpp"
 #include "Animations.hpp"
 
 #include "MovesetStructs.h"
@@ -13,12 +17,17 @@
 
 using namespace ByteswapHelpers;
 
+// Filepaths picked by GetFilepath() whose file hasn't been written yet
+// Extractions can run concurrently: two of them must never pick the same file, even before it exists on the disk
+static std::set<std::wstring> g_reservedFilepaths;
+static std::mutex g_reservedFilepathsMutex;
+
 // -- Helpers -- //
 
 namespace ExtractorUtils
 {
 
-	void WriteFileData(std::ofstream &file, const std::vector<std::pair<Byte*, uint64_t>>& blocks, uint8_t&progress, uint8_t progress_max)
+	void WriteFileData(std::ofstream &file, const std::vector<std::pair<Byte*, uint64_t>>& blocks, std::atomic<uint8_t>& progress, uint8_t progress_max)
 	{
 		uint8_t remainingProgress = progress_max - progress;
 		uint8_t step = (uint8_t)((size_t)remainingProgress / blocks.size());
@@ -38,8 +47,109 @@ namespace ExtractorUtils
 	{
 		if (settings & ExtractSettings_CompressLZMA) return TKMovesetCompressionType_LZMA;
 		if (settings & ExtractSettings_CompressLZ4) return TKMovesetCompressionType_LZ4;
+		if (settings & ExtractSettings_CompressZSTD) return TKMovesetCompressionType_ZSTD;
 		return TKMovesetCompressionType_None;
 	}
+
+	ExtractionErrcode_ WriteMovesetFile(const std::wstring& filepath, const std::wstring& tmp_filepath, TKMovesetHeader& header,
+		const std::vector<std::pair<Byte*, uint64_t>>& writtenBlocks, const std::vector<std::pair<Byte*, uint64_t>>& hashedBlocks, ExtractSettings settings, std::atomic<uint8_t>& progress)
+	{
+		// Whatever the outcome, the filepath can be given to other extractions once we are done with it
+		struct FilepathReservation {
+			const std::wstring& filepath;
+			~FilepathReservation() {
+				std::lock_guard<std::mutex> lock(g_reservedFilepathsMutex);
+				g_reservedFilepaths.erase(filepath);
+			}
+		} reservation{ filepath };
+
+		// Hashing runs alongside the compression / writing of the blocks, it doesn't modify them
+		// The header's CRC32 fields are only filled in the written file once both are done
+		header.crc32 = 0;
+		header.orig_crc32 = 0;
+		uint32_t crc32 = 0;
+		// Concurrent extractions already keep every hardware thread busy: hash after writing instead of starting yet another thread
+		const bool hashInParallel = Helpers::ReserveThreads(1) == 1;
+		std::thread hashingThread;
+		if (hashInParallel) {
+			hashingThread = std::thread([&crc32, &hashedBlocks]() {
+				crc32 = Helpers::CalculateCrc32(hashedBlocks);
+			});
+		}
+
+		ExtractionErrcode_ errcode = ExtractionErrcode_Successful;
+		TKMovesetCompressionType_ compressionType = GetCompressionAlgorithm(settings);
+
+		if (compressionType != TKMovesetCompressionType_None)
+		{
+			// Compress straight from the extracted blocks, the uncompressed moveset never touches the disk
+			DEBUG_LOG("Compressing moveset...\n");
+
+			// The file we are about to replace is the previous extraction of the same character
+			std::wstring previousFilepath;
+			if ((settings & ExtractSettings_ReuseExistingFile) && Helpers::fileExists(filepath.c_str())) {
+				previousFilepath = filepath;
+			}
+
+			if (!CompressionUtils::FILE::Moveset::Compress(tmp_filepath, writtenBlocks, compressionType, previousFilepath)) {
+				errcode = ExtractionErrcode_CompressionFailure;
+			}
+		}
+		else
+		{
+			DEBUG_LOG("Not compressing.\n");
+			std::ofstream file(tmp_filepath, std::ios::binary);
+
+			if (file.fail()) {
+				errcode = ExtractionErrcode_FileCreationErr;
+			}
+			else {
+				WriteFileData(file, writtenBlocks, progress, 95);
+				if (file.fail()) {
+					errcode = ExtractionErrcode_FileCreationErr;
+				}
+			}
+		}
+
+		if (hashInParallel) {
+			hashingThread.join();
+			Helpers::ReleaseThreads(1);
+		}
+		else {
+			crc32 = Helpers::CalculateCrc32(hashedBlocks);
+		}
+		header.crc32 = crc32;
+		header.orig_crc32 = crc32;
+
+		if (errcode == ExtractionErrcode_Successful)
+		{
+			// The header is always stored uncompressed at the start of the file, compressed or not
+			std::fstream file(tmp_filepath, std::ios::binary | std::ios::in | std::ios::out);
+			file.seekp(offsetof(TKMovesetHeader, crc32));
+			file.write((char*)&header.crc32, sizeof(header.crc32) + sizeof(header.orig_crc32));
+			if (file.fail()) {
+				errcode = ExtractionErrcode_FileCreationErr;
+			}
+		}
+
+		if (errcode != ExtractionErrcode_Successful) {
+			std::error_code ec;
+			std::filesystem::remove(tmp_filepath, ec);
+			return errcode;
+		}
+
+		progress = 95;
+
+		// Only replace the final file once the new one is fully written
+		try {
+			std::filesystem::rename(tmp_filepath, filepath);
+		}
+		catch (std::exception&) {
+			return ExtractionErrcode_FileCreationErr;
+		}
+
+		return ExtractionErrcode_Successful;
+	}
 };
 
 // Private methods //
@@ -100,12 +210,18 @@ void Extractor::GetFilepath(const char* characterName, std::wstring& out, std::w
 
 	std::wstring filePath = GenerateFilename(characterName, gameIdentifierstring, MOVESET_FILENAME_EXTENSION, 0);
 
-	if (!overwriteSameFilename && Helpers::fileExists(filePath.c_str())) {
+	std::lock_guard<std::mutex> lock(g_reservedFilepathsMutex);
+	auto isFilepathTaken = [](const std::wstring& path) {
+		return g_reservedFilepaths.contains(path) || Helpers::fileExists(path.c_str());
+	};
+
+	// Overwriting is fine, but not while another extraction is writing the same file
+	if ((!overwriteSameFilename && isFilepathTaken(filePath)) || g_reservedFilepaths.contains(filePath)) {
 		// File exists: try to add numbered suffix, loop until we find a free one
 		unsigned int counter = 2;
 		filePath = GenerateFilename(characterName, gameIdentifierstring, MOVESET_FILENAME_EXTENSION, counter);
 
-		while (Helpers::fileExists(filePath.c_str())) {
+		while (isFilepathTaken(filePath)) {
 			filePath = GenerateFilename(characterName, gameIdentifierstring, MOVESET_FILENAME_EXTENSION, counter);
 			counter++;
 		}
@@ -118,6 +234,40 @@ void Extractor::GetFilepath(const char* characterName, std::wstring& out, std::w
 		out = filePath;
 		out_tmp = GenerateFilename(characterName, gameIdentifierstring, MOVESET_TMPFILENAME_EXTENSION);
 	}
+
+	// Released by ExtractorUtils::WriteMovesetFile()
+	g_reservedFilepaths.insert(out);
+}
+
+gameAddr Extractor::FindStringEnd(gameAddr addr)
+{
+	Byte chunk[GAME_READ_CACHE_PAGE_SIZE];
+
+	while (true)
+	{
+		// Stop at the page end: the next page may not be mapped, which would make the whole read fail
+		size_t chunkSize = GAME_READ_CACHE_PAGE_SIZE - (addr % GAME_READ_CACHE_PAGE_SIZE);
+		GameProcessReadRequest request = { .addr = addr, .buf = chunk, .size = chunkSize };
+
+		if (!m_game.ReadBatch(&request, 1))
+		{
+			// Go byte per byte like before if the chunk can't be read as a whole
+			for (size_t i = 0; i < chunkSize; ++i) {
+				if (m_game.Read<uint8_t>(addr + i) == 0) {
+					return addr + i;
+				}
+			}
+		}
+		else
+		{
+			const Byte* terminator = (Byte*)memchr(chunk, 0, chunkSize);
+			if (terminator != nullptr) {
+				return addr + (terminator - chunk);
+			}
+		}
+
+		addr += chunkSize;
+	}
 }
 
 uint64_t Extractor::GetAnimationSize(gameAddr anim)
@@ -151,4 +301,27 @@ uint64_t Extractor::GetAnimationSize(gameAddr anim)
 
 	throw;
 	return 0;
-}
\ No newline at end of file
+}
+
+std::vector<std::string> Extractor::GetPlayerCharacterNames(const std::vector<gameAddr>& playerAddresses)
+{
+	std::vector<std::string> names;
+	for (gameAddr playerAddress : playerAddresses) {
+		names.push_back(GetPlayerCharacterName(playerAddress));
+	}
+	return names;
+}
+
+std::vector<uint64_t> Extractor::GetPlayerMovesetPtrs(const std::vector<gameAddr>& playerAddresses)
+{
+	uint64_t motbinOffset = m_game.GetValue("motbin_offset");
+	std::vector<gameAddr> ptrAddresses;
+	for (gameAddr playerAddress : playerAddresses) {
+		ptrAddresses.push_back(playerAddress + motbinOffset);
+	}
+
+	// Read with the game's own ptr size: 4-byte ptrs are not followed by unrelated data that would make the value change
+	std::vector<uint64_t> movesetPtrs(playerAddresses.size(), 0);
+	m_game.ReadPtrs(ptrAddresses.data(), movesetPtrs.data(), ptrAddresses.size());
+	return movesetPtrs;
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <fstream>
+#include <atomic>
 
 #include "GameData.hpp"
 #include "GameProcess.hpp"
@@ -25,9 +26,13 @@ enum ExtractionErrcode_
 namespace ExtractorUtils
 {
 	// Write a list of blocks, each aligned on a 8 bytes basis
-	void WriteFileData(std::ofstream& file, const std::vector<std::pair<Byte*, uint64_t>>& blocks, uint8_t& progress, uint8_t progress_max);
+	void WriteFileData(std::ofstream& file, const std::vector<std::pair<Byte*, uint64_t>>& blocks, std::atomic<uint8_t>& progress, uint8_t progress_max);
 	// Returns the compression algorithm depending on extraction settings
 	TKMovesetCompressionType_ GetCompressionAlgorithm(ExtractSettings settings);
+	// Calculates the moveset CRC32 and writes the blocks (compressed if requested by the settings) to [tmp_filepath], renamed to [filepath] once complete
+	// The CRC32 is calculated in parallel of the compression & writing, [hashedBlocks] must not contain the header
+	ExtractionErrcode_ WriteMovesetFile(const std::wstring& filepath, const std::wstring& tmp_filepath, TKMovesetHeader& header,
+		const std::vector<std::pair<Byte*, uint64_t>>& writtenBlocks, const std::vector<std::pair<Byte*, uint64_t>>& hashedBlocks, ExtractSettings settings, std::atomic<uint8_t>& progress);
 };
 
 // Base class for extracting from a game
@@ -43,8 +48,11 @@ protected:
 	// Calculates a block size from start to end, writes it to &size_out and return a pointer pointing to a new allocated space containing the data in the block
 	Byte* allocateAndReadBlock(gameAddr blockStart, gameAddr blockEnd, uint64_t& size_out);
 	// Generates the full filepath and the full tmp filepath to write to
+	// The filepath is reserved until ExtractorUtils::WriteMovesetFile() is done with it, concurrent extractions will not pick it
 	void GetFilepath(const char* characterName, std::wstring& out, std::wstring& out_tmp, bool overwriteSameFilename);
 
+	// Returns the address of the null terminator of the game string at [addr]. The string is read in chunks that never cross a page.
+	gameAddr FindStringEnd(gameAddr addr);
 	// Returns the amount of bytes an animation contains
 	uint64_t GetAnimationSize(gameAddr anim);
 public:
@@ -52,11 +60,15 @@ public:
 	using BaseGameSpecificClass::BaseGameSpecificClass;
 
 	// Pure virtual base method meant to do the heavy lifting
-	virtual ExtractionErrcode_ Extract(gameAddr playerAddress, ExtractSettings settings, uint8_t& progress) = 0;
+	virtual ExtractionErrcode_ Extract(gameAddr playerAddress, ExtractSettings settings, std::atomic<uint8_t>& progress) = 0;
 	// Returns true if extraction is possible (characters have been loaded)...
 	virtual bool CanExtract() = 0;
 	// Returns a string containing the character name of the provided player address
 	virtual std::string GetPlayerCharacterName(gameAddr playerAddress) = 0;
+	// Returns the character names of multiple players. Override to read them in batches, by default they are read one by one.
+	virtual std::vector<std::string> GetPlayerCharacterNames(const std::vector<gameAddr>& playerAddresses);
+	// Reads the moveset ptr of every player at once, failed reads give 0. Used to detect character changes.
+	std::vector<uint64_t> GetPlayerMovesetPtrs(const std::vector<gameAddr>& playerAddresses);
 	// Returns the ID of the character, actually important toward making movesets work properly
 	virtual uint32_t GetCharacterID(gameAddr playerAddress) = 0;
 	// Returns a character address depending on the provided playerid
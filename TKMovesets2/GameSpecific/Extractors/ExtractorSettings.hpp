@@ -34,5 +34,13 @@ enum ExtractSettings_
 
 	ExtractSettings_UnknownMotas = (1 << 16),
 
-	ExtractSettings_Compress = ExtractSettings_CompressLZMA | ExtractSettings_CompressLZ4,
+	ExtractSettings_CompressZSTD = (1 << 17),
+
+	// Records everything read during the extraction into a snapshot file that can be replayed without the game
+	ExtractSettings_RecordSnapshot = (1 << 18),
+
+	// When overwriting a compressed moveset, copies the parts that did not change from it instead of compressing them again
+	ExtractSettings_ReuseExistingFile = (1 << 19),
+
+	ExtractSettings_Compress = ExtractSettings_CompressLZMA | ExtractSettings_CompressLZ4 | ExtractSettings_CompressZSTD,
 };
@@ -80,7 +80,7 @@ private:
 
 public:
 	using Extractor::Extractor; // Inherit constructor too
-	ExtractionErrcode_ Extract(gameAddr playerAddress, ExtractSettings settings, uint8_t& progress) override;
+	ExtractionErrcode_ Extract(gameAddr playerAddress, ExtractSettings settings, std::atomic<uint8_t>& progress) override;
 	bool CanExtract() override;
 
 	std::string GetPlayerCharacterName(gameAddr playerAddress) override;
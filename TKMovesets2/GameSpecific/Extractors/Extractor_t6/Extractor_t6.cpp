@@ -5,10 +5,9 @@
 #include <iterator>
 #include <vector>
 #include <algorithm>
-#include <filesystem>
+#include <thread>
 
 #include "helpers.hpp"
-#include "Compression.hpp"
 #include "Extractor_t6.hpp"
 #include "Animations.hpp"
 
@@ -18,129 +17,137 @@ using namespace StructsT6;
 
 static void convertMovesetDataToLittleEndian(Byte* movesetBlock, const MovesetTable* offsets)
 {
-	for (auto& pushbackExtra : StructIterator<PushbackExtradata>(movesetBlock, offsets->pushbackExtradata, offsets->pushbackExtradataCount))
-	{
-		ByteswapHelpers::SWAP_INT16(&pushbackExtra.horizontal_offset);
-	}
-
-	for (auto& pushback : StructIterator<Pushback>(movesetBlock, offsets->pushback, offsets->pushbackCount))
-	{
-		ByteswapHelpers::SWAP_INT16(&pushback.duration);
-		ByteswapHelpers::SWAP_INT16(&pushback.displacement);
-		ByteswapHelpers::SWAP_INT32(&pushback.num_of_loops);
-		ByteswapHelpers::SWAP_INT32(&pushback.extradata_addr);
-	}
-
-	for (auto& req : StructIterator<Requirement>(movesetBlock, offsets->requirement, offsets->requirementCount))
-	{
-		ByteswapHelpers::SWAP_INT32(&req.condition);
-		ByteswapHelpers::SWAP_INT32(&req.param_unsigned);
-	}
-
-	for (auto& cancelExtra : StructIterator<CancelExtradata>(movesetBlock, offsets->cancelExtradata, offsets->cancelExtradataCount))
-	{
-		ByteswapHelpers::SWAP_INT32(&cancelExtra.value);
-	}
-
-	for (auto& cancel : StructIterator<Cancel>(movesetBlock, offsets->cancel, offsets->cancelCount))
-	{
-		ByteswapHelpers::SWAP_INT32(&cancel.direction);
-		ByteswapHelpers::SWAP_INT32(&cancel.button);
-
-		ByteswapHelpers::SWAP_INT32(&cancel.requirements_addr);
-		ByteswapHelpers::SWAP_INT32(&cancel.extradata_addr);
-		ByteswapHelpers::SWAP_INT32(&cancel.detection_start);
-		ByteswapHelpers::SWAP_INT32(&cancel.detection_end);
-		ByteswapHelpers::SWAP_INT32(&cancel.starting_frame);
-		ByteswapHelpers::SWAP_INT16(&cancel.move_id);
-		ByteswapHelpers::SWAP_INT16(&cancel.cancel_option);
-	}
-
-	for (auto& groupCancel : StructIterator<Cancel>(movesetBlock, offsets->groupCancel, offsets->groupCancelCount))
-	{
-		ByteswapHelpers::SWAP_INT32(&groupCancel.direction);
-		ByteswapHelpers::SWAP_INT32(&groupCancel.button);
-
-		ByteswapHelpers::SWAP_INT32(&groupCancel.requirements_addr);
-		ByteswapHelpers::SWAP_INT32(&groupCancel.extradata_addr);
-		ByteswapHelpers::SWAP_INT32(&groupCancel.detection_start);
-		ByteswapHelpers::SWAP_INT32(&groupCancel.detection_end);
-		ByteswapHelpers::SWAP_INT32(&groupCancel.starting_frame);
-		ByteswapHelpers::SWAP_INT16(&groupCancel.move_id);
-		ByteswapHelpers::SWAP_INT16(&groupCancel.cancel_option);
-	}
-
-	for (auto& reaction : StructIterator<Reactions>(movesetBlock, offsets->reactions, offsets->reactionsCount))
-	{
-		ByteswapHelpers::SWAP_INT32(&reaction.front_pushback);
-		ByteswapHelpers::SWAP_INT32(&reaction.backturned_pushback);
-		ByteswapHelpers::SWAP_INT32(&reaction.left_side_pushback);
-		ByteswapHelpers::SWAP_INT32(&reaction.right_side_pushback);
-		ByteswapHelpers::SWAP_INT32(&reaction.front_counterhit_pushback);
-		ByteswapHelpers::SWAP_INT32(&reaction.downed_pushback);
-		ByteswapHelpers::SWAP_INT32(&reaction.block_pushback);
-
-		ByteswapHelpers::SWAP_INT16(&reaction.front_direction);
-		ByteswapHelpers::SWAP_INT16(&reaction.back_direction);
-		ByteswapHelpers::SWAP_INT16(&reaction.left_side_direction);
-		ByteswapHelpers::SWAP_INT16(&reaction.right_side_direction);
-		ByteswapHelpers::SWAP_INT16(&reaction.front_counterhit_direction);
-		ByteswapHelpers::SWAP_INT16(&reaction.downed_direction);
-
-		ByteswapHelpers::SWAP_INT32(&reaction._0x28_int);
-		ByteswapHelpers::SWAP_INT32(&reaction._0x2C_int);
-
-		ByteswapHelpers::SWAP_INT16(&reaction.vertical_pushback);
-		ByteswapHelpers::SWAP_INT16(&reaction.standing_moveid);
-		ByteswapHelpers::SWAP_INT16(&reaction.default_moveid);
-		ByteswapHelpers::SWAP_INT16(&reaction.crouch_moveid);
-		ByteswapHelpers::SWAP_INT16(&reaction.counterhit_moveid);
-		ByteswapHelpers::SWAP_INT16(&reaction.crouch_counterhit_moveid);
-		ByteswapHelpers::SWAP_INT16(&reaction.left_side_moveid);
-		ByteswapHelpers::SWAP_INT16(&reaction.crouch_left_side_moveid);
-		ByteswapHelpers::SWAP_INT16(&reaction.right_side_moveid);
-		ByteswapHelpers::SWAP_INT16(&reaction.crouch_right_side_moveid);
-		ByteswapHelpers::SWAP_INT16(&reaction.backturned_moveid);
-		ByteswapHelpers::SWAP_INT16(&reaction.crouch_backturned_moveid);
-		ByteswapHelpers::SWAP_INT16(&reaction.block_moveid);
-		ByteswapHelpers::SWAP_INT16(&reaction.crouch_block_moveid);
-		ByteswapHelpers::SWAP_INT16(&reaction.wallslump_moveid);
-		ByteswapHelpers::SWAP_INT16(&reaction.downed_moveid);
-	}
-
-	for (auto& hitCondition : StructIterator<HitCondition>(movesetBlock, offsets->hitCondition, offsets->hitConditionCount))
-	{
-		ByteswapHelpers::SWAP_INT32(&hitCondition.requirements_addr);
-		ByteswapHelpers::SWAP_INT32(&hitCondition.damage);
-		ByteswapHelpers::SWAP_INT32(&hitCondition.reactions_addr);
-	}
+	static constexpr ByteswapField pushbackExtraFields[] = {
+		BYTESWAP_FIELD(PushbackExtradata, horizontal_offset),
+	};
+	static_assert(ByteswapHelpers::IsValidLayout(sizeof(PushbackExtradata), pushbackExtraFields));
+	static const ByteswapLayout pushbackExtraLayout(sizeof(PushbackExtradata), pushbackExtraFields);
+	pushbackExtraLayout.Swap(movesetBlock + offsets->pushbackExtradata, offsets->pushbackExtradataCount);
+
+	static constexpr ByteswapField pushbackFields[] = {
+		BYTESWAP_FIELD(Pushback, duration),
+		BYTESWAP_FIELD(Pushback, displacement),
+		BYTESWAP_FIELD(Pushback, num_of_loops),
+		BYTESWAP_FIELD(Pushback, extradata_addr),
+	};
+	static_assert(ByteswapHelpers::IsValidLayout(sizeof(Pushback), pushbackFields));
+	static const ByteswapLayout pushbackLayout(sizeof(Pushback), pushbackFields);
+	pushbackLayout.Swap(movesetBlock + offsets->pushback, offsets->pushbackCount);
 
-	for (auto& voiceclip : StructIterator<Voiceclip>(movesetBlock, offsets->voiceclip, offsets->voiceclipCount))
-	{
-		ByteswapHelpers::SWAP_INT32(&voiceclip.id);
-	}
+	static constexpr ByteswapField reqFields[] = {
+		BYTESWAP_FIELD(Requirement, condition),
+		BYTESWAP_FIELD(Requirement, param_unsigned),
+	};
+	static_assert(ByteswapHelpers::IsValidLayout(sizeof(Requirement), reqFields));
+	static const ByteswapLayout reqLayout(sizeof(Requirement), reqFields);
+	reqLayout.Swap(movesetBlock + offsets->requirement, offsets->requirementCount);
 
-	for (auto& extraProp : StructIterator<ExtraMoveProperty>(movesetBlock, offsets->extraMoveProperty, offsets->extraMovePropertyCount))
-	{
-		ByteswapHelpers::SWAP_INT32(&extraProp.starting_frame);
-		ByteswapHelpers::SWAP_INT32(&extraProp.id);
-		ByteswapHelpers::SWAP_INT32(&extraProp.value_unsigned);
-	}
+	static constexpr ByteswapField cancelExtraFields[] = {
+		BYTESWAP_FIELD(CancelExtradata, value),
+	};
+	static_assert(ByteswapHelpers::IsValidLayout(sizeof(CancelExtradata), cancelExtraFields));
+	static const ByteswapLayout cancelExtraLayout(sizeof(CancelExtradata), cancelExtraFields);
+	cancelExtraLayout.Swap(movesetBlock + offsets->cancelExtradata, offsets->cancelExtradataCount);
+
+	static constexpr ByteswapField cancelFields[] = {
+		BYTESWAP_FIELD(Cancel, direction),
+		BYTESWAP_FIELD(Cancel, button),
+
+		BYTESWAP_FIELD(Cancel, requirements_addr),
+		BYTESWAP_FIELD(Cancel, extradata_addr),
+		BYTESWAP_FIELD(Cancel, detection_start),
+		BYTESWAP_FIELD(Cancel, detection_end),
+		BYTESWAP_FIELD(Cancel, starting_frame),
+		BYTESWAP_FIELD(Cancel, move_id),
+		BYTESWAP_FIELD(Cancel, cancel_option),
+	};
+	static_assert(ByteswapHelpers::IsValidLayout(sizeof(Cancel), cancelFields));
+	static const ByteswapLayout cancelLayout(sizeof(Cancel), cancelFields);
+	cancelLayout.Swap(movesetBlock + offsets->cancel, offsets->cancelCount);
+	cancelLayout.Swap(movesetBlock + offsets->groupCancel, offsets->groupCancelCount);
+
+	static constexpr ByteswapField reactionFields[] = {
+		BYTESWAP_FIELD(Reactions, front_pushback),
+		BYTESWAP_FIELD(Reactions, backturned_pushback),
+		BYTESWAP_FIELD(Reactions, left_side_pushback),
+		BYTESWAP_FIELD(Reactions, right_side_pushback),
+		BYTESWAP_FIELD(Reactions, front_counterhit_pushback),
+		BYTESWAP_FIELD(Reactions, downed_pushback),
+		BYTESWAP_FIELD(Reactions, block_pushback),
+
+		BYTESWAP_FIELD(Reactions, front_direction),
+		BYTESWAP_FIELD(Reactions, back_direction),
+		BYTESWAP_FIELD(Reactions, left_side_direction),
+		BYTESWAP_FIELD(Reactions, right_side_direction),
+		BYTESWAP_FIELD(Reactions, front_counterhit_direction),
+		BYTESWAP_FIELD(Reactions, downed_direction),
+
+		BYTESWAP_FIELD(Reactions, _0x28_int),
+		BYTESWAP_FIELD(Reactions, _0x2C_int),
+
+		BYTESWAP_FIELD(Reactions, vertical_pushback),
+		BYTESWAP_FIELD(Reactions, standing_moveid),
+		BYTESWAP_FIELD(Reactions, default_moveid),
+		BYTESWAP_FIELD(Reactions, crouch_moveid),
+		BYTESWAP_FIELD(Reactions, counterhit_moveid),
+		BYTESWAP_FIELD(Reactions, crouch_counterhit_moveid),
+		BYTESWAP_FIELD(Reactions, left_side_moveid),
+		BYTESWAP_FIELD(Reactions, crouch_left_side_moveid),
+		BYTESWAP_FIELD(Reactions, right_side_moveid),
+		BYTESWAP_FIELD(Reactions, crouch_right_side_moveid),
+		BYTESWAP_FIELD(Reactions, backturned_moveid),
+		BYTESWAP_FIELD(Reactions, crouch_backturned_moveid),
+		BYTESWAP_FIELD(Reactions, block_moveid),
+		BYTESWAP_FIELD(Reactions, crouch_block_moveid),
+		BYTESWAP_FIELD(Reactions, wallslump_moveid),
+		BYTESWAP_FIELD(Reactions, downed_moveid),
+	};
+	static_assert(ByteswapHelpers::IsValidLayout(sizeof(Reactions), reactionFields));
+	static const ByteswapLayout reactionLayout(sizeof(Reactions), reactionFields);
+	reactionLayout.Swap(movesetBlock + offsets->reactions, offsets->reactionsCount);
+
+	static constexpr ByteswapField hitConditionFields[] = {
+		BYTESWAP_FIELD(HitCondition, requirements_addr),
+		BYTESWAP_FIELD(HitCondition, damage),
+		BYTESWAP_FIELD(HitCondition, reactions_addr),
+	};
+	static_assert(ByteswapHelpers::IsValidLayout(sizeof(HitCondition), hitConditionFields));
+	static const ByteswapLayout hitConditionLayout(sizeof(HitCondition), hitConditionFields);
+	hitConditionLayout.Swap(movesetBlock + offsets->hitCondition, offsets->hitConditionCount);
 
-	for (auto& input : StructIterator<Input>(movesetBlock, offsets->input, offsets->inputCount))
-	{
-		ByteswapHelpers::SWAP_INT32(&input.direction);
-		ByteswapHelpers::SWAP_INT32(&input.button);
+	static constexpr ByteswapField voiceclipFields[] = {
+		BYTESWAP_FIELD(Voiceclip, id),
+	};
+	static_assert(ByteswapHelpers::IsValidLayout(sizeof(Voiceclip), voiceclipFields));
+	static const ByteswapLayout voiceclipLayout(sizeof(Voiceclip), voiceclipFields);
+	voiceclipLayout.Swap(movesetBlock + offsets->voiceclip, offsets->voiceclipCount);
+
+	static constexpr ByteswapField extraPropFields[] = {
+		BYTESWAP_FIELD(ExtraMoveProperty, starting_frame),
+		BYTESWAP_FIELD(ExtraMoveProperty, id),
+		BYTESWAP_FIELD(ExtraMoveProperty, value_unsigned),
+	};
+	static_assert(ByteswapHelpers::IsValidLayout(sizeof(ExtraMoveProperty), extraPropFields));
+	static const ByteswapLayout extraPropLayout(sizeof(ExtraMoveProperty), extraPropFields);
+	extraPropLayout.Swap(movesetBlock + offsets->extraMoveProperty, offsets->extraMovePropertyCount);
 
-	}
+	static constexpr ByteswapField inputFields[] = {
+		BYTESWAP_FIELD(Input, direction),
+		BYTESWAP_FIELD(Input, button),
+	};
+	static_assert(ByteswapHelpers::IsValidLayout(sizeof(Input), inputFields));
+	static const ByteswapLayout inputLayout(sizeof(Input), inputFields);
+	inputLayout.Swap(movesetBlock + offsets->input, offsets->inputCount);
 
-	for (auto& inputSequence : StructIterator<InputSequence>(movesetBlock, offsets->inputSequence, offsets->inputSequenceCount))
-	{
+	static constexpr ByteswapField inputSequenceFields[] = {
 		// 0x0: int8: not swapping
 		// 0x1: int8: not swapping
-		ByteswapHelpers::SWAP_INT16(&inputSequence.input_amount);
-		ByteswapHelpers::SWAP_INT32(&inputSequence.input_addr);
-	}
+		BYTESWAP_FIELD(InputSequence, input_amount),
+		BYTESWAP_FIELD(InputSequence, input_addr),
+	};
+	static_assert(ByteswapHelpers::IsValidLayout(sizeof(InputSequence), inputSequenceFields));
+	static const ByteswapLayout inputSequenceLayout(sizeof(InputSequence), inputSequenceFields);
+	inputSequenceLayout.Swap(movesetBlock + offsets->inputSequence, offsets->inputSequenceCount);
 
 	/*
 	for (auto& projectile : StructIterator<Projectile>(movesetBlock, offsets->projectile, offsets->projectileCount))
@@ -151,94 +158,100 @@ static void convertMovesetDataToLittleEndian(Byte* movesetBlock, const MovesetTa
 	}
 	*/
 
-	for (auto& cameraData : StructIterator<CameraData>(movesetBlock, offsets->cameraData, offsets->cameraDataCount))
-	{
-		ByteswapHelpers::SWAP_INT32(&cameraData._0x0_int);
-		ByteswapHelpers::SWAP_INT16(&cameraData._0x4_short);
-		ByteswapHelpers::SWAP_INT16(&cameraData.left_side_camera_data);
-		ByteswapHelpers::SWAP_INT16(&cameraData.right_side_camera_data);
-		ByteswapHelpers::SWAP_INT16(&cameraData._0xA_short);
-	}
-
-	for (auto& throwCameras : StructIterator<ThrowCamera>(movesetBlock, offsets->throwCameras, offsets->throwCamerasCount))
-	{
-		ByteswapHelpers::SWAP_INT32(&throwCameras._0x0_uint);
-		ByteswapHelpers::SWAP_INT32(&throwCameras.cameradata_addr);
-	}
-
-
-	for (auto& parryRelated : StructIterator<UnknownParryRelated>(movesetBlock, offsets->unknownParryRelated, offsets->unknownParryRelatedCount))
-	{
-		ByteswapHelpers::SWAP_INT32(&parryRelated.value);
-	}
-
-	for (auto& moveBeginningProp : StructIterator<OtherMoveProperty>(movesetBlock, offsets->moveBeginningProp, offsets->moveBeginningPropCount))
-	{
-		ByteswapHelpers::SWAP_INT32(&moveBeginningProp.requirements_addr);
-		ByteswapHelpers::SWAP_INT32(&moveBeginningProp.extraprop);
-		ByteswapHelpers::SWAP_INT32(&moveBeginningProp.value);
-	}
+	static constexpr ByteswapField cameraDataFields[] = {
+		BYTESWAP_FIELD(CameraData, _0x0_int),
+		BYTESWAP_FIELD(CameraData, _0x4_short),
+		BYTESWAP_FIELD(CameraData, left_side_camera_data),
+		BYTESWAP_FIELD(CameraData, right_side_camera_data),
+		BYTESWAP_FIELD(CameraData, _0xA_short),
+	};
+	static_assert(ByteswapHelpers::IsValidLayout(sizeof(CameraData), cameraDataFields));
+	static const ByteswapLayout cameraDataLayout(sizeof(CameraData), cameraDataFields);
+	cameraDataLayout.Swap(movesetBlock + offsets->cameraData, offsets->cameraDataCount);
 
-	for (auto& moveEndingProp : StructIterator<OtherMoveProperty>(movesetBlock, offsets->moveEndingProp, offsets->moveEndingPropCount))
-	{
-		ByteswapHelpers::SWAP_INT32(&moveEndingProp.requirements_addr);
-		ByteswapHelpers::SWAP_INT32(&moveEndingProp.extraprop);
-		ByteswapHelpers::SWAP_INT32(&moveEndingProp.value);
-	}
+	static constexpr ByteswapField throwCamerasFields[] = {
+		BYTESWAP_FIELD(ThrowCamera, _0x0_uint),
+		BYTESWAP_FIELD(ThrowCamera, cameradata_addr),
+	};
+	static_assert(ByteswapHelpers::IsValidLayout(sizeof(ThrowCamera), throwCamerasFields));
+	static const ByteswapLayout throwCamerasLayout(sizeof(ThrowCamera), throwCamerasFields);
+	throwCamerasLayout.Swap(movesetBlock + offsets->throwCameras, offsets->throwCamerasCount);
 
-	for (auto& move : StructIterator<Move>(movesetBlock, offsets->move, offsets->moveCount))
-	{
-		//ByteswapHelpers::SWAP_INT32(&move._0x0_int);
-		//ByteswapHelpers::SWAP_INT32(&move._0x4_int);
-
-		ByteswapHelpers::SWAP_INT32(&move.anim_addr);
-		ByteswapHelpers::SWAP_INT32(&move.vuln);
-		ByteswapHelpers::SWAP_INT32(&move.hitlevel);
-		ByteswapHelpers::SWAP_INT32(&move.cancel_addr);
-
-		ByteswapHelpers::SWAP_INT16(&move.transition);
-
-		ByteswapHelpers::SWAP_INT16(&move.moveId_val1);
-		ByteswapHelpers::SWAP_INT16(&move.moveId_val2);
-
-		ByteswapHelpers::SWAP_INT32(&move.hit_condition_addr);
-		ByteswapHelpers::SWAP_INT32(&move.anim_len);
-		ByteswapHelpers::SWAP_INT32(&move.airborne_start);
-		ByteswapHelpers::SWAP_INT32(&move.airborne_end);
-		ByteswapHelpers::SWAP_INT32(&move.ground_fall);
-		ByteswapHelpers::SWAP_INT32(&move.voicelip_addr);
-		ByteswapHelpers::SWAP_INT32(&move.extra_move_property_addr);
-		ByteswapHelpers::SWAP_INT32(&move.move_start_extraprop_addr);
-		ByteswapHelpers::SWAP_INT32(&move.move_end_extraprop_addr);
-		ByteswapHelpers::SWAP_INT32(&move._0x98_int);
-
-		//ByteswapHelpers::SWAP_INT32(&move.hitbox_location); // No need to swap this field
-
-		ByteswapHelpers::SWAP_INT32(&move.first_active_frame);
-		ByteswapHelpers::SWAP_INT32(&move.last_active_frame);
-		ByteswapHelpers::SWAP_INT16(&move._0x6c_short);
-		ByteswapHelpers::SWAP_INT16(&move.distance);
-	}
 
-	for (auto& mvlPlayable : StructIterator<MvlPlayable>(movesetBlock, offsets->mvlPlayable, offsets->mvlPlayableCount))
-	{
-		ByteswapHelpers::SWAP_INT16(&mvlPlayable.p2_action);
-		ByteswapHelpers::SWAP_INT16(&mvlPlayable.distance);
-		ByteswapHelpers::SWAP_INT16(&mvlPlayable.p2_rotation);
-		ByteswapHelpers::SWAP_INT16(&mvlPlayable._unk0x6);
-		ByteswapHelpers::SWAP_INT16(&mvlPlayable._unk0x8);
-		ByteswapHelpers::SWAP_INT16(&mvlPlayable.p1_facing_related);
-		ByteswapHelpers::SWAP_INT16(&mvlPlayable._unk0xc);
-		ByteswapHelpers::SWAP_INT16(&mvlPlayable.input_count);
-		ByteswapHelpers::SWAP_INT32(&mvlPlayable.input_addr);
-	}
+	static constexpr ByteswapField parryRelatedFields[] = {
+		BYTESWAP_FIELD(UnknownParryRelated, value),
+	};
+	static_assert(ByteswapHelpers::IsValidLayout(sizeof(UnknownParryRelated), parryRelatedFields));
+	static const ByteswapLayout parryRelatedLayout(sizeof(UnknownParryRelated), parryRelatedFields);
+	parryRelatedLayout.Swap(movesetBlock + offsets->unknownParryRelated, offsets->unknownParryRelatedCount);
+
+	static constexpr ByteswapField moveBeginningPropFields[] = {
+		BYTESWAP_FIELD(OtherMoveProperty, requirements_addr),
+		BYTESWAP_FIELD(OtherMoveProperty, extraprop),
+		BYTESWAP_FIELD(OtherMoveProperty, value),
+	};
+	static_assert(ByteswapHelpers::IsValidLayout(sizeof(OtherMoveProperty), moveBeginningPropFields));
+	static const ByteswapLayout moveBeginningPropLayout(sizeof(OtherMoveProperty), moveBeginningPropFields);
+	moveBeginningPropLayout.Swap(movesetBlock + offsets->moveBeginningProp, offsets->moveBeginningPropCount);
+	moveBeginningPropLayout.Swap(movesetBlock + offsets->moveEndingProp, offsets->moveEndingPropCount);
+
+	static constexpr ByteswapField moveFields[] = {
+		//BYTESWAP_FIELD(Move, _0x0_int),
+		//BYTESWAP_FIELD(Move, _0x4_int),
+
+		BYTESWAP_FIELD(Move, anim_addr),
+		BYTESWAP_FIELD(Move, vuln),
+		BYTESWAP_FIELD(Move, hitlevel),
+		BYTESWAP_FIELD(Move, cancel_addr),
+
+		BYTESWAP_FIELD(Move, transition),
+
+		BYTESWAP_FIELD(Move, moveId_val1),
+		BYTESWAP_FIELD(Move, moveId_val2),
+
+		BYTESWAP_FIELD(Move, hit_condition_addr),
+		BYTESWAP_FIELD(Move, anim_len),
+		BYTESWAP_FIELD(Move, airborne_start),
+		BYTESWAP_FIELD(Move, airborne_end),
+		BYTESWAP_FIELD(Move, ground_fall),
+		BYTESWAP_FIELD(Move, voicelip_addr),
+		BYTESWAP_FIELD(Move, extra_move_property_addr),
+		BYTESWAP_FIELD(Move, move_start_extraprop_addr),
+		BYTESWAP_FIELD(Move, move_end_extraprop_addr),
+		BYTESWAP_FIELD(Move, _0x98_int),
+
+		//BYTESWAP_FIELD(Move, hitbox_location), // No need to swap this field
+
+		BYTESWAP_FIELD(Move, first_active_frame),
+		BYTESWAP_FIELD(Move, last_active_frame),
+		BYTESWAP_FIELD(Move, _0x6c_short),
+		BYTESWAP_FIELD(Move, distance),
+	};
+	static_assert(ByteswapHelpers::IsValidLayout(sizeof(Move), moveFields));
+	static const ByteswapLayout moveLayout(sizeof(Move), moveFields);
+	moveLayout.Swap(movesetBlock + offsets->move, offsets->moveCount);
+
+	static constexpr ByteswapField mvlPlayableFields[] = {
+		BYTESWAP_FIELD(MvlPlayable, p2_action),
+		BYTESWAP_FIELD(MvlPlayable, distance),
+		BYTESWAP_FIELD(MvlPlayable, p2_rotation),
+		BYTESWAP_FIELD(MvlPlayable, _unk0x6),
+		BYTESWAP_FIELD(MvlPlayable, _unk0x8),
+		BYTESWAP_FIELD(MvlPlayable, p1_facing_related),
+		BYTESWAP_FIELD(MvlPlayable, _unk0xc),
+		BYTESWAP_FIELD(MvlPlayable, input_count),
+		BYTESWAP_FIELD(MvlPlayable, input_addr),
+	};
+	static_assert(ByteswapHelpers::IsValidLayout(sizeof(MvlPlayable), mvlPlayableFields));
+	static const ByteswapLayout mvlPlayableLayout(sizeof(MvlPlayable), mvlPlayableFields);
+	mvlPlayableLayout.Swap(movesetBlock + offsets->mvlPlayable, offsets->mvlPlayableCount);
 
-	for (auto& mvlDisplayable : StructIterator<MvlDisplayable>(movesetBlock, offsets->mvlPlayable, offsets->mvlPlayableCount))
-	{
-		for (unsigned int i = 0; i < _countof(mvlDisplayable.all_translation_offsets); ++i) {
-			ByteswapHelpers::SWAP_INT32(&mvlDisplayable.all_translation_offsets[i]);
-		}
-	}
+	static constexpr ByteswapField mvlDisplayableFields[] = {
+		BYTESWAP_ARRAY(MvlDisplayable, all_translation_offsets),
+	};
+	static_assert(ByteswapHelpers::IsValidLayout(sizeof(MvlDisplayable), mvlDisplayableFields));
+	static const ByteswapLayout mvlDisplayableLayout(sizeof(MvlDisplayable), mvlDisplayableFields);
+	mvlDisplayableLayout.Swap(movesetBlock + offsets->mvlPlayable, offsets->mvlPlayableCount);
 
 	if (offsets->StructA3Count != 0)
 	{
@@ -718,7 +731,7 @@ void ExtractorT6::FillHeaderInfos(TKMovesetHeader& infos, gameAddr playerAddress
 
 // -- Public methods -- //
 
-ExtractionErrcode_ ExtractorT6::Extract(gameAddr playerAddress, ExtractSettings settings, uint8_t& progress)
+ExtractionErrcode_ ExtractorT6::Extract(gameAddr playerAddress, ExtractSettings settings, std::atomic<uint8_t>& progress)
 {
 	progress = 0;
 	// These are all the blocks we are going to extract. Most of them will be ripped in one big readBytes()
@@ -790,9 +803,11 @@ ExtractionErrcode_ ExtractorT6::Extract(gameAddr playerAddress, ExtractSettings
 	}
 	progress = 20;
 
-	// Read mota list, allocate & copy desired mota, prepare anim list to properly guess size of anims later
-	motaCustomBlock = CopyMotaBlocks(movesetAddr, s_motaCustomBlock, &motasList, settings);
-	progress = 50;
+	// The pointer conversion doesn't depend on these blocks: read them while the rest is being read & converted
+	std::thread parallelReadThread([&]() {
+		// Read mota list, allocate & copy desired mota
+		motaCustomBlock = CopyMotaBlocks(movesetAddr, s_motaCustomBlock, &motasList, settings);
+	});
 
 	// Extract animations and build a map for their old address -> their new offset in our blocks
 	std::map<gameAddr, uint64_t> animOffsets;
@@ -808,6 +823,9 @@ ExtractionErrcode_ ExtractorT6::Extract(gameAddr playerAddress, ExtractSettings
 
 	// Now that we extracted everything, we can properly convert pts to indexes
 	convertMovesetPointersToIndexes(movesetBlock, table, offsets, animOffsets);
+
+	// Wait for the blocks read in parallel
+	parallelReadThread.join();
 	progress = 75;
 
 	// -- Extraction & data conversion finished --
@@ -849,70 +867,44 @@ ExtractionErrcode_ ExtractorT6::Extract(gameAddr playerAddress, ExtractSettings
 
 		GetFilepath(characterName.c_str(), filepath, tmp_filepath, (settings & ExtractSettings_OVERWRITE_SAME_FILENAME) != 0);
 
-		std::ofstream file(tmp_filepath.c_str(), std::ios::binary);
-
-		if (!file.fail())
-		{
-			progress = 80;
-
-
-			// List of blocks that will be written to the file. Each block is 8 bytes aligned
-			std::vector<std::pair<Byte*, uint64_t>> writtenFileBlocks{
-				// Header block containing important moveset informations
-				{headerBlock, s_headerBlock},
-				// Custom block of variable length containing a list of custom properties to apply on import
-				{customPropertiesBlock, s_customProperties},
-				// Contains the list of moveset data blocks' offsets
-				{offsetListBlock, s_offsetListBlock},
-
-				// Actual moveset data start. Accurate up to the animation block
-				{movesetInfoBlock, s_movesetInfoBlock},
-				{(Byte*)nameBlock, s_nameBlock},
-				{movesetBlock, s_movesetBlock},
-				{animationBlock, s_animationBlock},
-				{motaCustomBlock, s_motaCustomBlock},
-			};
-
-			// List of blocks used for the CRC32 calculation. Some blocks above are purposefully ignored.
-			// Every block that can be manually modified is in there
-			std::vector<std::pair<Byte*, uint64_t>> hashedFileBlocks{
-				{customPropertiesBlock, s_customProperties},
-
-				{movesetInfoBlock, s_movesetInfoBlock},
-				{movesetBlock, s_movesetBlock},
-				{animationBlock, s_animationBlock},
-				{motaCustomBlock, s_motaCustomBlock},
-			};
-
-			customHeader.crc32 = Helpers::CalculateCrc32(hashedFileBlocks);
-			customHeader.orig_crc32 = customHeader.crc32;
-			ExtractorUtils::WriteFileData(file, writtenFileBlocks, progress, 95);
-
-			file.close();
-
-			if (settings & ExtractSettings_Compress) {
-				DEBUG_LOG("Saved temp moveset, compressing...\n");
-				if (!CompressionUtils::FILE::Moveset::Compress(filepath, tmp_filepath, ExtractorUtils::GetCompressionAlgorithm(settings))) {
-					errcode = ExtractionErrcode_CompressionFailure;
-				}
-			}
-			else {
-				DEBUG_LOG("Not compressing.\n");
-				try {
-                    std::filesystem::rename(tmp_filepath, filepath);
-                } catch (std::exception&) {
-                    errcode = ExtractionErrcode_FileCreationErr;
-                }
-			}
-
+		progress = 80;
+
+		// List of blocks that will be written to the file. Each block is 8 bytes aligned
+		std::vector<std::pair<Byte*, uint64_t>> writtenFileBlocks{
+			// Header block containing important moveset informations
+			{headerBlock, s_headerBlock},
+			// Custom block of variable length containing a list of custom properties to apply on import
+			{customPropertiesBlock, s_customProperties},
+			// Contains the list of moveset data blocks' offsets
+			{offsetListBlock, s_offsetListBlock},
+
+			// Actual moveset data start. Accurate up to the animation block
+			{movesetInfoBlock, s_movesetInfoBlock},
+			{(Byte*)nameBlock, s_nameBlock},
+			{movesetBlock, s_movesetBlock},
+			{animationBlock, s_animationBlock},
+			{motaCustomBlock, s_motaCustomBlock},
+		};
+
+		// List of blocks used for the CRC32 calculation. Some blocks above are purposefully ignored.
+		// Every block that can be manually modified is in there
+		std::vector<std::pair<Byte*, uint64_t>> hashedFileBlocks{
+			{customPropertiesBlock, s_customProperties},
+
+			{movesetInfoBlock, s_movesetInfoBlock},
+			{movesetBlock, s_movesetBlock},
+			{animationBlock, s_animationBlock},
+			{motaCustomBlock, s_motaCustomBlock},
+		};
+
+		errcode = ExtractorUtils::WriteMovesetFile(filepath, tmp_filepath, customHeader, writtenFileBlocks, hashedFileBlocks, settings, progress);
+
+		if (errcode == ExtractionErrcode_Successful) {
 			DEBUG_LOG("- Saved moveset at '%S' -\n", filepath.c_str());
-
-			progress = 100;
-			// Extraction is over
-		}
-		else {
-			errcode = ExtractionErrcode_FileCreationErr;
 		}
+
+		progress = 100;
+		// Extraction is over
 	}
 
 
@@ -4,11 +4,11 @@
 #include <stddef.h>
 #include <iterator>
 #include <vector>
+#include <array>
 #include <algorithm>
-#include <filesystem>
+#include <thread>
 
 #include "helpers.hpp"
-#include "Compression.hpp"
 #include "Extractor_t7.hpp"
 #include "Animations.hpp"
 
@@ -29,87 +29,72 @@ static void convertMovesetPointersToIndexes(Byte* movesetBlock, const gAddr::Mov
 		move.name_addr -= nameStart;
 		move.anim_name_addr -= nameStart;
 		move.anim_addr = animOffsetMap[move.anim_addr];
-		TO_INDEX(move.cancel_addr, table.cancel, Cancel);
-		TO_INDEX(move._0x28_cancel_addr, table.cancel, Cancel);
-		TO_INDEX(move._0x38_cancel_addr, table.cancel, Cancel);
-		TO_INDEX(move._0x48_cancel_addr, table.cancel, Cancel);
-		TO_INDEX(move.hit_condition_addr, table.hitCondition, HitCondition);
-		TO_INDEX(move.voicelip_addr, table.voiceclip, Voiceclip);
-		TO_INDEX(move.extra_move_property_addr, table.extraMoveProperty, ExtraMoveProperty);
-		TO_INDEX(move.move_start_extraprop_addr, table.moveBeginningProp, OtherMoveProperty);
-		TO_INDEX(move.move_end_extraprop_addr, table.moveEndingProp, OtherMoveProperty);
 	}
+	Helpers::convertPtrsToIndexes(movesetBlock + offsets->move, sizeof(gAddr::Move), table.moveCount, {
+		{ offsetof(gAddr::Move, cancel_addr), table.cancel, sizeof(Cancel) },
+		{ offsetof(gAddr::Move, _0x28_cancel_addr), table.cancel, sizeof(Cancel) },
+		{ offsetof(gAddr::Move, _0x38_cancel_addr), table.cancel, sizeof(Cancel) },
+		{ offsetof(gAddr::Move, _0x48_cancel_addr), table.cancel, sizeof(Cancel) },
+		{ offsetof(gAddr::Move, hit_condition_addr), table.hitCondition, sizeof(HitCondition) },
+		{ offsetof(gAddr::Move, voicelip_addr), table.voiceclip, sizeof(Voiceclip) },
+		{ offsetof(gAddr::Move, extra_move_property_addr), table.extraMoveProperty, sizeof(ExtraMoveProperty) },
+		{ offsetof(gAddr::Move, move_start_extraprop_addr), table.moveBeginningProp, sizeof(OtherMoveProperty) },
+		{ offsetof(gAddr::Move, move_end_extraprop_addr), table.moveEndingProp, sizeof(OtherMoveProperty) },
+	});
 
 	// Convert projectile ptrs
-	for (auto& projectile : StructIterator<gAddr::Projectile>(movesetBlock, offsets->projectile, table.projectileCount))
-	{
-		// One projectile actually has both at 0 for some reason ?
-		TO_INDEX(projectile.cancel_addr, table.cancel, Cancel);
-		TO_INDEX(projectile.hit_condition_addr, table.hitCondition, HitCondition);
-	}
-
-	// Convert cancel ptrs
-	for (auto& cancel : StructIterator<gAddr::Cancel>(movesetBlock, offsets->cancel, table.cancelCount))
-	{
-		TO_INDEX(cancel.requirements_addr, table.requirement, Requirement);
-		TO_INDEX(cancel.extradata_addr, table.cancelExtradata, CancelExtradata);
-	}
-
-	// Convert groupCancel cancel ptrs
-	for (auto& groupCancel : StructIterator<gAddr::Cancel>(movesetBlock, offsets->groupCancel, table.groupCancelCount))
-	{
-		TO_INDEX(groupCancel.requirements_addr, table.requirement, Requirement);
-		TO_INDEX(groupCancel.extradata_addr, table.cancelExtradata, CancelExtradata);
-	}
+	// One projectile actually has both at 0 for some reason ?
+	Helpers::convertPtrsToIndexes(movesetBlock + offsets->projectile, sizeof(gAddr::Projectile), table.projectileCount, {
+		{ offsetof(gAddr::Projectile, cancel_addr), table.cancel, sizeof(Cancel) },
+		{ offsetof(gAddr::Projectile, hit_condition_addr), table.hitCondition, sizeof(HitCondition) },
+	});
+
+	// Convert cancel & groupCancel ptrs
+	const std::initializer_list<StructPtrField> cancelFields = {
+		{ offsetof(gAddr::Cancel, requirements_addr), table.requirement, sizeof(Requirement) },
+		{ offsetof(gAddr::Cancel, extradata_addr), table.cancelExtradata, sizeof(CancelExtradata) },
+	};
+	Helpers::convertPtrsToIndexes(movesetBlock + offsets->cancel, sizeof(gAddr::Cancel), table.cancelCount, cancelFields);
+	Helpers::convertPtrsToIndexes(movesetBlock + offsets->groupCancel, sizeof(gAddr::Cancel), table.groupCancelCount, cancelFields);
 
 	// Convert reaction ptrs
-	for (auto& reaction : StructIterator<gAddr::Reactions>(movesetBlock, offsets->reactions, table.reactionsCount))
-	{
-		TO_INDEX(reaction.front_pushback, table.pushback, Pushback);
-		TO_INDEX(reaction.backturned_pushback, table.pushback, Pushback);
-		TO_INDEX(reaction.left_side_pushback, table.pushback, Pushback);
-		TO_INDEX(reaction.right_side_pushback, table.pushback, Pushback);
-		TO_INDEX(reaction.front_counterhit_pushback, table.pushback, Pushback);
-		TO_INDEX(reaction.downed_pushback, table.pushback, Pushback);
-		TO_INDEX(reaction.block_pushback, table.pushback, Pushback);
-	}
+	Helpers::convertPtrsToIndexes(movesetBlock + offsets->reactions, sizeof(gAddr::Reactions), table.reactionsCount, {
+		{ offsetof(gAddr::Reactions, front_pushback), table.pushback, sizeof(Pushback) },
+		{ offsetof(gAddr::Reactions, backturned_pushback), table.pushback, sizeof(Pushback) },
+		{ offsetof(gAddr::Reactions, left_side_pushback), table.pushback, sizeof(Pushback) },
+		{ offsetof(gAddr::Reactions, right_side_pushback), table.pushback, sizeof(Pushback) },
+		{ offsetof(gAddr::Reactions, front_counterhit_pushback), table.pushback, sizeof(Pushback) },
+		{ offsetof(gAddr::Reactions, downed_pushback), table.pushback, sizeof(Pushback) },
+		{ offsetof(gAddr::Reactions, block_pushback), table.pushback, sizeof(Pushback) },
+	});
 
 	// Convert input sequence ptrs
-	for (auto& inputSequence : StructIterator<gAddr::InputSequence>(movesetBlock, offsets->inputSequence, table.inputSequenceCount))
-	{
-		TO_INDEX(inputSequence.input_addr, table.input, Input);
-	}
+	Helpers::convertPtrsToIndexes(movesetBlock + offsets->inputSequence, sizeof(gAddr::InputSequence), table.inputSequenceCount, {
+		{ offsetof(gAddr::InputSequence, input_addr), table.input, sizeof(Input) },
+	});
 
 	// Convert throwCameras ptrs
-	for (auto& throwCameras : StructIterator<gAddr::ThrowCamera>(movesetBlock, offsets->throwCameras, table.throwCamerasCount))
-	{
-		TO_INDEX(throwCameras.cameradata_addr, table.cameraData, CameraData);
-	}
+	Helpers::convertPtrsToIndexes(movesetBlock + offsets->throwCameras, sizeof(gAddr::ThrowCamera), table.throwCamerasCount, {
+		{ offsetof(gAddr::ThrowCamera, cameradata_addr), table.cameraData, sizeof(CameraData) },
+	});
 
 	// Convert hit conditions ptrs
-	for (auto& hitCondition : StructIterator<gAddr::HitCondition>(movesetBlock, offsets->hitCondition, table.hitConditionCount))
-	{
-		TO_INDEX(hitCondition.requirements_addr, table.requirement, Requirement);
-		TO_INDEX(hitCondition.reactions_addr, table.reactions, Reactions);
-	}
+	Helpers::convertPtrsToIndexes(movesetBlock + offsets->hitCondition, sizeof(gAddr::HitCondition), table.hitConditionCount, {
+		{ offsetof(gAddr::HitCondition, requirements_addr), table.requirement, sizeof(Requirement) },
+		{ offsetof(gAddr::HitCondition, reactions_addr), table.reactions, sizeof(Reactions) },
+	});
 
 	// Convert pushback ptrs
-	for (auto& pushback : StructIterator<gAddr::Pushback>(movesetBlock, offsets->pushback, table.pushbackCount))
-	{
-		TO_INDEX(pushback.extradata_addr, table.pushbackExtradata, PushbackExtradata);
-	}
+	Helpers::convertPtrsToIndexes(movesetBlock + offsets->pushback, sizeof(gAddr::Pushback), table.pushbackCount, {
+		{ offsetof(gAddr::Pushback, extradata_addr), table.pushbackExtradata, sizeof(PushbackExtradata) },
+	});
 
-	// Convert move start prop ptrs
-	for (auto& moveBeginningProp : StructIterator<gAddr::OtherMoveProperty>(movesetBlock, offsets->moveBeginningProp, table.moveBeginningPropCount))
-	{
-		TO_INDEX(moveBeginningProp.requirements_addr, table.requirement, Requirement);
-	}
-
-	// Convert move end prop ptrs
-	for (auto& moveEndingProp : StructIterator<gAddr::OtherMoveProperty>(movesetBlock, offsets->moveEndingProp, table.moveEndingPropCount))
-	{
-		TO_INDEX(moveEndingProp.requirements_addr, table.requirement, Requirement);
-	}
+	// Convert move start & end prop ptrs
+	const std::initializer_list<StructPtrField> otherPropFields = {
+		{ offsetof(gAddr::OtherMoveProperty, requirements_addr), table.requirement, sizeof(Requirement) },
+	};
+	Helpers::convertPtrsToIndexes(movesetBlock + offsets->moveBeginningProp, sizeof(gAddr::OtherMoveProperty), table.moveBeginningPropCount, otherPropFields);
+	Helpers::convertPtrsToIndexes(movesetBlock + offsets->moveEndingProp, sizeof(gAddr::OtherMoveProperty), table.moveEndingPropCount, otherPropFields);
 }
 
 // -- Private methods - //
@@ -306,10 +291,7 @@ void ExtractorT7::GetNamesBlockBounds(const gAddr::Move* move, uint64_t moveCoun
 	}
 
 	// Move to the last string's END instead of staying at the start
-	gameAddr lastItemEnd = (gameAddr)highest;
-	while (m_process.readInt8(lastItemEnd) != 0) {
-		lastItemEnd += 1;
-	}
+	gameAddr lastItemEnd = FindStringEnd((gameAddr)highest);
 
 	start = smallest;
 	end = lastItemEnd + 1; // Add 1 to extract the nullbyte too
@@ -537,7 +519,7 @@ void ExtractorT7::FillHeaderInfos(TKMovesetHeader& infos, gameAddr playerAddress
 
 // -- Public methods -- //
 
-ExtractionErrcode_ ExtractorT7::Extract(gameAddr playerAddress, ExtractSettings settings, uint8_t& progress)
+ExtractionErrcode_ ExtractorT7::Extract(gameAddr playerAddress, ExtractSettings settings, std::atomic<uint8_t>& progress)
 {
 	progress = 0;
 	// These are all the blocks we are going to extract. Most of them will be ripped in one big readBytes()
@@ -617,13 +599,14 @@ ExtractionErrcode_ ExtractorT7::Extract(gameAddr playerAddress, ExtractSettings
 	}
 	progress = 20;
 
-	// movelistBlock
-	movelistBlock = CopyDisplayableMovelist(movesetAddr, playerAddress, s_movelistBlock, settings);
-	progress = 35;
+	// The pointer conversion doesn't depend on these blocks: read them while the rest is being read & converted
+	std::thread parallelReadThread([&]() {
+		// movelistBlock
+		movelistBlock = CopyDisplayableMovelist(movesetAddr, playerAddress, s_movelistBlock, settings);
 
-	// Read mota list, allocate & copy desired mota, prepare anim list to properly guess size of anims later
-	motaCustomBlock = CopyMotaBlocks(movesetAddr, s_motaCustomBlock, &motasList, settings);
-	progress = 50;
+		// Read mota list, allocate & copy desired mota
+		motaCustomBlock = CopyMotaBlocks(movesetAddr, s_motaCustomBlock, &motasList, settings);
+	});
 
 	// Extract animations and build a map for their old address -> their new offset in our blocks
 	std::map<gameAddr, uint64_t> animOffsets;
@@ -640,6 +623,9 @@ ExtractionErrcode_ ExtractorT7::Extract(gameAddr playerAddress, ExtractSettings
 
 	// Now that we extracted everything, we can properly convert pts to indexes
 	convertMovesetPointersToIndexes(movesetBlock, table, offsets, nameBlockStart, animOffsets);
+
+	// Wait for the blocks read in parallel
+	parallelReadThread.join();
 	progress = 75;
 
 	// -- Extraction & data conversion finished --
@@ -684,76 +670,50 @@ ExtractionErrcode_ ExtractorT7::Extract(gameAddr playerAddress, ExtractSettings
 		
 		GetFilepath(characterName.c_str(), filepath, tmp_filepath, (settings & ExtractSettings_OVERWRITE_SAME_FILENAME) != 0);
 
-		std::ofstream file(tmp_filepath.c_str(), std::ios::binary);
-
-		if (!file.fail())
-		{
-			progress = 80;
-
-
-			// List of blocks that will be written to the file. Each block is 8 bytes aligned
-			std::vector<std::pair<Byte*, uint64_t>> writtenFileBlocks{
-				// Header block containing important moveset informations
-				{headerBlock, s_headerBlock},
-				// Custom block of variable length containing a list of custom properties to apply on import
-				{customPropertiesBlock, s_customProperties},
-				// Contains the list of moveset data blocks' offsets
-				{offsetListBlock, s_offsetListBlock},
-
-				// Actual moveset data start. Accurate up to the animation block
-				{movesetInfoBlock, s_movesetInfoBlock},
-				{tableBlock, s_tableBlock },
-				{motasListBlock, s_motasListBlock},
-				{(Byte*)nameBlock, s_nameBlock},
-				{movesetBlock, s_movesetBlock},
-				{animationBlock, s_animationBlock},
-				{motaCustomBlock, s_motaCustomBlock},
-				// Displayable movelist block
-				{movelistBlock, s_movelistBlock},
-			};
-
-			// List of blocks used for the CRC32 calculation. Some blocks above are purposefully ignored.
-			// Every block that can be manually modified is in there
-			std::vector<std::pair<Byte*, uint64_t>> hashedFileBlocks{
-				{customPropertiesBlock, s_customProperties},
-
-				{movesetInfoBlock, s_movesetInfoBlock},
-				{tableBlock, s_tableBlock },
-				{motasListBlock, s_motasListBlock},
-				{movesetBlock, s_movesetBlock},
-				{animationBlock, s_animationBlock},
-				{motaCustomBlock, s_motaCustomBlock},
-			};
-
-			customHeader.crc32 = Helpers::CalculateCrc32(hashedFileBlocks);
-			customHeader.orig_crc32 = customHeader.crc32;
-			ExtractorUtils::WriteFileData(file, writtenFileBlocks, progress, 95);
-
-			file.close();
-
-			if (settings & ExtractSettings_Compress) {
-				DEBUG_LOG("Saved temp moveset, compressing...\n");
-				if (!CompressionUtils::FILE::Moveset::Compress(filepath, tmp_filepath, ExtractorUtils::GetCompressionAlgorithm(settings))) {
-					errcode = ExtractionErrcode_CompressionFailure;
-				}
-			}
-			else {
-				DEBUG_LOG("Not compressing.\n");
-                try {
-                    std::filesystem::rename(tmp_filepath, filepath);
-                } catch (std::exception&) {
-                    errcode = ExtractionErrcode_FileCreationErr;
-                }
-			}
-
+		progress = 80;
+
+		// List of blocks that will be written to the file. Each block is 8 bytes aligned
+		std::vector<std::pair<Byte*, uint64_t>> writtenFileBlocks{
+			// Header block containing important moveset informations
+			{headerBlock, s_headerBlock},
+			// Custom block of variable length containing a list of custom properties to apply on import
+			{customPropertiesBlock, s_customProperties},
+			// Contains the list of moveset data blocks' offsets
+			{offsetListBlock, s_offsetListBlock},
+
+			// Actual moveset data start. Accurate up to the animation block
+			{movesetInfoBlock, s_movesetInfoBlock},
+			{tableBlock, s_tableBlock },
+			{motasListBlock, s_motasListBlock},
+			{(Byte*)nameBlock, s_nameBlock},
+			{movesetBlock, s_movesetBlock},
+			{animationBlock, s_animationBlock},
+			{motaCustomBlock, s_motaCustomBlock},
+			// Displayable movelist block
+			{movelistBlock, s_movelistBlock},
+		};
+
+		// List of blocks used for the CRC32 calculation. Some blocks above are purposefully ignored.
+		// Every block that can be manually modified is in there
+		std::vector<std::pair<Byte*, uint64_t>> hashedFileBlocks{
+			{customPropertiesBlock, s_customProperties},
+
+			{movesetInfoBlock, s_movesetInfoBlock},
+			{tableBlock, s_tableBlock },
+			{motasListBlock, s_motasListBlock},
+			{movesetBlock, s_movesetBlock},
+			{animationBlock, s_animationBlock},
+			{motaCustomBlock, s_motaCustomBlock},
+		};
+
+		errcode = ExtractorUtils::WriteMovesetFile(filepath, tmp_filepath, customHeader, writtenFileBlocks, hashedFileBlocks, settings, progress);
+
+		if (errcode == ExtractionErrcode_Successful) {
 			DEBUG_LOG("- Saved moveset at '%S' -\n", filepath.c_str());
-
-			progress = 100;
-			// Extraction is over
-		}
-		else {
-			errcode = ExtractionErrcode_FileCreationErr;
 		}
+
+		progress = 100;
+		// Extraction is over
 	}
 
 
@@ -826,18 +786,9 @@ bool ExtractorT7::CanExtract()
 }
 
 
-std::string ExtractorT7::GetPlayerCharacterName(gameAddr playerAddress)
+// Turns a character name read from a moveset into something more readable. '[CHARACTER_NAME.s]' becomes 'Character Name.S'
+static std::string FormatCharacterName(char* characterName)
 {
-	gameAddr movesetAddr = m_process.readInt64(playerAddress + m_game.GetValue("motbin_offset"));
-
-	if (movesetAddr == 0) {
-		return "";
-	}
-
-	char characterName[32];
-	m_game.ReadBytes(movesetAddr + 0x2E8, characterName, sizeof(characterName));
-	characterName[sizeof(characterName) - 1] = '\0';
-
 	auto name_len = strlen(characterName);
 
 	if (name_len == 0) {
@@ -846,7 +797,6 @@ std::string ExtractorT7::GetPlayerCharacterName(gameAddr playerAddress)
 
 	char* character_name_cursor = characterName;
 
-	// Turn name into something more readable. '[CHARACTER_NAME.s]' becomes 'Character Name.S'
 	if (*character_name_cursor == '[') {
 		++character_name_cursor;
 	}
@@ -879,6 +829,60 @@ std::string ExtractorT7::GetPlayerCharacterName(gameAddr playerAddress)
 	return character_name_cursor;
 }
 
+std::string ExtractorT7::GetPlayerCharacterName(gameAddr playerAddress)
+{
+	gameAddr movesetAddr = m_process.readInt64(playerAddress + m_game.GetValue("motbin_offset"));
+
+	if (movesetAddr == 0) {
+		return "";
+	}
+
+	char characterName[32];
+	m_game.ReadBytes(movesetAddr + 0x2E8, characterName, sizeof(characterName));
+	characterName[sizeof(characterName) - 1] = '\0';
+
+	return FormatCharacterName(characterName);
+}
+
+std::vector<std::string> ExtractorT7::GetPlayerCharacterNames(const std::vector<gameAddr>& playerAddresses)
+{
+	size_t playerCount = playerAddresses.size();
+	uint64_t motbinOffset = m_game.GetValue("motbin_offset");
+
+	std::vector<gameAddr> movesetAddrs(playerCount, 0);
+	// Players without a moveset keep an empty name
+	std::vector<std::array<char, 32>> characterNames(playerCount);
+	std::vector<GameProcessReadRequest> requests;
+
+	// Read the moveset of every player, then the name of every moveset: two batches instead of two reads per player
+	for (size_t i = 0; i < playerCount; ++i) {
+		requests.push_back({ .addr = playerAddresses[i] + motbinOffset, .buf = &movesetAddrs[i], .size = sizeof(gameAddr) });
+	}
+	m_process.readBatch(requests.data(), requests.size());
+
+	std::vector<GameProcessReadRequest> nameRequests;
+	for (size_t i = 0; i < playerCount; ++i) {
+		if (requests[i].success && movesetAddrs[i] != 0) {
+			nameRequests.push_back({ .addr = movesetAddrs[i] + 0x2E8, .buf = characterNames[i].data(), .size = characterNames[i].size() });
+		}
+	}
+	m_game.ReadBatch(nameRequests.data(), nameRequests.size());
+
+	for (auto& request : nameRequests) {
+		if (!request.success) {
+			memset(request.buf, 0, request.size);
+		}
+	}
+
+	std::vector<std::string> names;
+	for (auto& characterName : characterNames)
+	{
+		characterName.back() = '\0';
+		names.push_back(FormatCharacterName(characterName.data()));
+	}
+	return names;
+}
+
 uint32_t ExtractorT7::GetCharacterID(gameAddr playerAddress)
 {
 	return m_process.readInt16(playerAddress + m_game.GetValue("chara_id_offset"));
@@ -45,10 +45,11 @@ private:
 
 public:
 	using Extractor::Extractor; // Inherit constructor too
-	ExtractionErrcode_ Extract(gameAddr playerAddress, ExtractSettings settings, uint8_t& progress) override;
+	ExtractionErrcode_ Extract(gameAddr playerAddress, ExtractSettings settings, std::atomic<uint8_t>& progress) override;
 	bool CanExtract() override;
 
 	std::string GetPlayerCharacterName(gameAddr playerAddress) override;
+	std::vector<std::string> GetPlayerCharacterNames(const std::vector<gameAddr>& playerAddresses) override;
 	uint32_t GetCharacterID(gameAddr playerAddress) override;
 	gameAddr GetCharacterAddress(uint8_t playerId) override;
 	std::vector<gameAddr> GetCharacterAddresses() override;
@@ -5,10 +5,8 @@
 #include <iterator>
 #include <vector>
 #include <algorithm>
-#include <filesystem>
 
 #include "helpers.hpp"
-#include "Compression.hpp"
 #include "Extractor_t8.hpp"
 #include "Animations.hpp"
 
@@ -24,101 +22,81 @@ using namespace StructsT8;
 static void convertMovesetPointersToIndexes(Byte* movesetBlock, const gAddr::MovesetTable& table, const gAddr::MovesetTable* offsets)
 {
 	// Convert move ptrs
-	for (auto& move : StructIterator<gAddr::Move>(movesetBlock, offsets->move, table.moveCount))
-	{
-		TO_INDEX(move.cancel_addr, table.cancel, Cancel);
-		TO_INDEX(move.cancel1_addr, table.cancel, Cancel);
-		TO_INDEX(move.cancel2_addr, table.cancel, Cancel);
-		TO_INDEX(move.cancel3_addr, table.cancel, Cancel);
-		TO_INDEX(move.hit_condition_addr, table.hitCondition, HitCondition);
-		TO_INDEX(move.voicelip_addr, table.voiceclip, Voiceclip);
-		TO_INDEX(move.extra_move_property_addr, table.extraMoveProperty, ExtraMoveProperty);
-		TO_INDEX(move.move_start_extraprop_addr, table.moveBeginningProp, OtherMoveProperty);
-		TO_INDEX(move.move_end_extraprop_addr, table.moveEndingProp, OtherMoveProperty);
-	}
+	Helpers::convertPtrsToIndexes(movesetBlock + offsets->move, sizeof(gAddr::Move), table.moveCount, {
+		{ offsetof(gAddr::Move, cancel_addr), table.cancel, sizeof(Cancel) },
+		{ offsetof(gAddr::Move, cancel1_addr), table.cancel, sizeof(Cancel) },
+		{ offsetof(gAddr::Move, cancel2_addr), table.cancel, sizeof(Cancel) },
+		{ offsetof(gAddr::Move, cancel3_addr), table.cancel, sizeof(Cancel) },
+		{ offsetof(gAddr::Move, hit_condition_addr), table.hitCondition, sizeof(HitCondition) },
+		{ offsetof(gAddr::Move, voicelip_addr), table.voiceclip, sizeof(Voiceclip) },
+		{ offsetof(gAddr::Move, extra_move_property_addr), table.extraMoveProperty, sizeof(ExtraMoveProperty) },
+		{ offsetof(gAddr::Move, move_start_extraprop_addr), table.moveBeginningProp, sizeof(OtherMoveProperty) },
+		{ offsetof(gAddr::Move, move_end_extraprop_addr), table.moveEndingProp, sizeof(OtherMoveProperty) },
+	});
 
 	// Convert projectile ptrs
-	for (auto& projectile : StructIterator<gAddr::Projectile>(movesetBlock, offsets->projectile, table.projectileCount))
-	{
-		// One projectile actually has both at 0 for some reason ?
-		TO_INDEX(projectile.cancel_addr, table.cancel, Cancel);
-		TO_INDEX(projectile.hit_condition_addr, table.hitCondition, HitCondition);
-	}
-
-	// Convert cancel ptrs
-	for (auto& cancel : StructIterator<gAddr::Cancel>(movesetBlock, offsets->cancel, table.cancelCount))
-	{
-		TO_INDEX(cancel.requirements_addr, table.requirement, Requirement);
-		TO_INDEX(cancel.extradata_addr, table.cancelExtradata, CancelExtradata);
-	}
-
-	// Convert groupCancel cancel ptrs
-	for (auto& groupCancel : StructIterator<gAddr::Cancel>(movesetBlock, offsets->groupCancel, table.groupCancelCount))
-	{
-		TO_INDEX(groupCancel.requirements_addr, table.requirement, Requirement);
-		TO_INDEX(groupCancel.extradata_addr, table.cancelExtradata, CancelExtradata);
-	}
+	// One projectile actually has both at 0 for some reason ?
+	Helpers::convertPtrsToIndexes(movesetBlock + offsets->projectile, sizeof(gAddr::Projectile), table.projectileCount, {
+		{ offsetof(gAddr::Projectile, cancel_addr), table.cancel, sizeof(Cancel) },
+		{ offsetof(gAddr::Projectile, hit_condition_addr), table.hitCondition, sizeof(HitCondition) },
+	});
+
+	// Convert cancel & groupCancel ptrs
+	const std::initializer_list<StructPtrField> cancelFields = {
+		{ offsetof(gAddr::Cancel, requirements_addr), table.requirement, sizeof(Requirement) },
+		{ offsetof(gAddr::Cancel, extradata_addr), table.cancelExtradata, sizeof(CancelExtradata) },
+	};
+	Helpers::convertPtrsToIndexes(movesetBlock + offsets->cancel, sizeof(gAddr::Cancel), table.cancelCount, cancelFields);
+	Helpers::convertPtrsToIndexes(movesetBlock + offsets->groupCancel, sizeof(gAddr::Cancel), table.groupCancelCount, cancelFields);
 
 	// Convert reaction ptrs
-	for (auto& reaction : StructIterator<gAddr::Reactions>(movesetBlock, offsets->reactions, table.reactionsCount))
-	{
-		TO_INDEX(reaction.front_pushback, table.pushback, Pushback);
-		TO_INDEX(reaction.backturned_pushback, table.pushback, Pushback);
-		TO_INDEX(reaction.left_side_pushback, table.pushback, Pushback);
-		TO_INDEX(reaction.right_side_pushback, table.pushback, Pushback);
-		TO_INDEX(reaction.front_counterhit_pushback, table.pushback, Pushback);
-		TO_INDEX(reaction.downed_pushback, table.pushback, Pushback);
-		TO_INDEX(reaction.block_pushback, table.pushback, Pushback);
-	}
+	Helpers::convertPtrsToIndexes(movesetBlock + offsets->reactions, sizeof(gAddr::Reactions), table.reactionsCount, {
+		{ offsetof(gAddr::Reactions, front_pushback), table.pushback, sizeof(Pushback) },
+		{ offsetof(gAddr::Reactions, backturned_pushback), table.pushback, sizeof(Pushback) },
+		{ offsetof(gAddr::Reactions, left_side_pushback), table.pushback, sizeof(Pushback) },
+		{ offsetof(gAddr::Reactions, right_side_pushback), table.pushback, sizeof(Pushback) },
+		{ offsetof(gAddr::Reactions, front_counterhit_pushback), table.pushback, sizeof(Pushback) },
+		{ offsetof(gAddr::Reactions, downed_pushback), table.pushback, sizeof(Pushback) },
+		{ offsetof(gAddr::Reactions, block_pushback), table.pushback, sizeof(Pushback) },
+	});
 
 	// Convert input sequence ptrs
-	for (auto& inputSequence : StructIterator<gAddr::InputSequence>(movesetBlock, offsets->inputSequence, table.inputSequenceCount))
-	{
-		TO_INDEX(inputSequence.input_addr, table.input, Input);
-	}
+	Helpers::convertPtrsToIndexes(movesetBlock + offsets->inputSequence, sizeof(gAddr::InputSequence), table.inputSequenceCount, {
+		{ offsetof(gAddr::InputSequence, input_addr), table.input, sizeof(Input) },
+	});
 
 	// Convert throwCameras ptrs
-	for (auto& throwCameras : StructIterator<gAddr::ThrowCamera>(movesetBlock, offsets->throwCameras, table.throwCamerasCount))
-	{
-		TO_INDEX(throwCameras.cameradata_addr, table.cameraData, CameraData);
-	}
+	Helpers::convertPtrsToIndexes(movesetBlock + offsets->throwCameras, sizeof(gAddr::ThrowCamera), table.throwCamerasCount, {
+		{ offsetof(gAddr::ThrowCamera, cameradata_addr), table.cameraData, sizeof(CameraData) },
+	});
 
 	// Convert hit conditions ptrs
-	for (auto& hitCondition : StructIterator<gAddr::HitCondition>(movesetBlock, offsets->hitCondition, table.hitConditionCount))
-	{
-		TO_INDEX(hitCondition.requirements_addr, table.requirement, Requirement);
-		TO_INDEX(hitCondition.reactions_addr, table.reactions, Reactions);
-	}
+	Helpers::convertPtrsToIndexes(movesetBlock + offsets->hitCondition, sizeof(gAddr::HitCondition), table.hitConditionCount, {
+		{ offsetof(gAddr::HitCondition, requirements_addr), table.requirement, sizeof(Requirement) },
+		{ offsetof(gAddr::HitCondition, reactions_addr), table.reactions, sizeof(Reactions) },
+	});
 
 	// Convert pushback ptrs
-	for (auto& pushback : StructIterator<gAddr::Pushback>(movesetBlock, offsets->pushback, table.pushbackCount))
-	{
-		TO_INDEX(pushback.extradata_addr, table.pushbackExtradata, PushbackExtradata);
-	}
-
-	// Convert move start prop ptrs
-	for (auto& moveBeginningProp : StructIterator<gAddr::OtherMoveProperty>(movesetBlock, offsets->moveBeginningProp, table.moveBeginningPropCount))
-	{
-		TO_INDEX(moveBeginningProp.requirements_addr, table.requirement, Requirement);
-	}
-
-	// Convert move end prop ptrs
-	for (auto& moveEndingProp : StructIterator<gAddr::OtherMoveProperty>(movesetBlock, offsets->moveEndingProp, table.moveEndingPropCount))
-	{
-		TO_INDEX(moveEndingProp.requirements_addr, table.requirement, Requirement);
-	}
-
-	// Convert move end prop ptrs
-	for (auto& extraMoveProperty : StructIterator<gAddr::ExtraMoveProperty>(movesetBlock, offsets->extraMoveProperty, table.extraMovePropertyCount))
-	{
-		TO_INDEX(extraMoveProperty.requirements_addr, table.requirement, Requirement);
-	}
+	Helpers::convertPtrsToIndexes(movesetBlock + offsets->pushback, sizeof(gAddr::Pushback), table.pushbackCount, {
+		{ offsetof(gAddr::Pushback, extradata_addr), table.pushbackExtradata, sizeof(PushbackExtradata) },
+	});
 
-	// Convert move end prop ptrs
-	for (auto& dialogueManager : StructIterator<gAddr::DialogueManager>(movesetBlock, offsets->dialoguesData, table.dialoguesDataCount))
-	{
-		TO_INDEX(dialogueManager.requirements_addr, table.requirement, Requirement);
-	}
+	// Convert move start & end prop ptrs
+	const std::initializer_list<StructPtrField> otherPropFields = {
+		{ offsetof(gAddr::OtherMoveProperty, requirements_addr), table.requirement, sizeof(Requirement) },
+	};
+	Helpers::convertPtrsToIndexes(movesetBlock + offsets->moveBeginningProp, sizeof(gAddr::OtherMoveProperty), table.moveBeginningPropCount, otherPropFields);
+	Helpers::convertPtrsToIndexes(movesetBlock + offsets->moveEndingProp, sizeof(gAddr::OtherMoveProperty), table.moveEndingPropCount, otherPropFields);
+
+	// Convert extra move property ptrs
+	Helpers::convertPtrsToIndexes(movesetBlock + offsets->extraMoveProperty, sizeof(gAddr::ExtraMoveProperty), table.extraMovePropertyCount, {
+		{ offsetof(gAddr::ExtraMoveProperty, requirements_addr), table.requirement, sizeof(Requirement) },
+	});
+
+	// Convert dialogue ptrs
+	Helpers::convertPtrsToIndexes(movesetBlock + offsets->dialoguesData, sizeof(gAddr::DialogueManager), table.dialoguesDataCount, {
+		{ offsetof(gAddr::DialogueManager, requirements_addr), table.requirement, sizeof(Requirement) },
+	});
 }
 
 // -- Private methods - //
@@ -315,10 +293,7 @@ void ExtractorT8::GetNamesBlockBounds(const gAddr::Move* move, uint64_t moveCoun
 	}
 
 	// Move to the last string's END instead of staying at the start
-	gameAddr lastItemEnd = (gameAddr)highest;
-	while (m_process.readInt8(lastItemEnd) != 0) {
-		lastItemEnd += 1;
-	}
+	gameAddr lastItemEnd = FindStringEnd((gameAddr)highest);
 
 	start = smallest;
 	end = lastItemEnd + 1; // Add 1 to extract the nullbyte too
@@ -487,7 +462,7 @@ void ExtractorT8::FillHeaderInfos(TKMovesetHeader& infos, gameAddr playerAddress
 
 // -- Public methods -- //
 
-ExtractionErrcode_ ExtractorT8::Extract(gameAddr playerAddress, ExtractSettings settings, uint8_t& progress)
+ExtractionErrcode_ ExtractorT8::Extract(gameAddr playerAddress, ExtractSettings settings, std::atomic<uint8_t>& progress)
 {
 	progress = 0;
 	// These are all the blocks we are going to extract. Most of them will be ripped in one big readBytes()
@@ -600,68 +575,42 @@ ExtractionErrcode_ ExtractorT8::Extract(gameAddr playerAddress, ExtractSettings
 		
 		GetFilepath(characterName.c_str(), filepath, tmp_filepath, (settings & ExtractSettings_OVERWRITE_SAME_FILENAME) != 0);
 
-		std::ofstream file(tmp_filepath.c_str(), std::ios::binary);
-
-		if (!file.fail())
-		{
-			progress = 80;
-
-
-			// List of blocks that will be written to the file. Each block is 8 bytes aligned
-			std::vector<std::pair<Byte*, uint64_t>> writtenFileBlocks{
-				// Header block containing important moveset informations
-				{headerBlock, s_headerBlock},
-				// Custom block of variable length containing a list of custom properties to apply on import
-				{customPropertiesBlock, s_customProperties},
-				// Contains the list of moveset data blocks' offsets
-				{offsetListBlock, s_offsetListBlock},
-
-				// Actual moveset data start. Accurate up to the animation block
-				{movesetInfoBlock, s_movesetInfoBlock},
-				{tableBlock, s_tableBlock },
-				// {(Byte*)nameBlock, s_nameBlock},
-				{movesetBlock, s_movesetBlock},
-			};
-
-			// List of blocks used for the CRC32 calculation. Some blocks above are purposefully ignored.
-			// Every block that can be manually modified is in there
-			std::vector<std::pair<Byte*, uint64_t>> hashedFileBlocks{
-				{customPropertiesBlock, s_customProperties},
-
-				{movesetInfoBlock, s_movesetInfoBlock},
-				{tableBlock, s_tableBlock },
-				{movesetBlock, s_movesetBlock},
-			};
-
-			customHeader.crc32 = Helpers::CalculateCrc32(hashedFileBlocks);
-			customHeader.orig_crc32 = customHeader.crc32;
-			ExtractorUtils::WriteFileData(file, writtenFileBlocks, progress, 95);
-
-			file.close();
-
-			if (settings & ExtractSettings_Compress) {
-				DEBUG_LOG("Saved temp moveset, compressing...\n");
-				if (!CompressionUtils::FILE::Moveset::Compress(filepath, tmp_filepath, ExtractorUtils::GetCompressionAlgorithm(settings))) {
-					errcode = ExtractionErrcode_CompressionFailure;
-				}
-			}
-			else {
-				DEBUG_LOG("Not compressing.\n");
-                try {
-                    std::filesystem::rename(tmp_filepath, filepath);
-                } catch (std::exception&) {
-                    errcode = ExtractionErrcode_FileCreationErr;
-                }
-			}
-
+		progress = 80;
+
+		// List of blocks that will be written to the file. Each block is 8 bytes aligned
+		std::vector<std::pair<Byte*, uint64_t>> writtenFileBlocks{
+			// Header block containing important moveset informations
+			{headerBlock, s_headerBlock},
+			// Custom block of variable length containing a list of custom properties to apply on import
+			{customPropertiesBlock, s_customProperties},
+			// Contains the list of moveset data blocks' offsets
+			{offsetListBlock, s_offsetListBlock},
+
+			// Actual moveset data start. Accurate up to the animation block
+			{movesetInfoBlock, s_movesetInfoBlock},
+			{tableBlock, s_tableBlock },
+			// {(Byte*)nameBlock, s_nameBlock},
+			{movesetBlock, s_movesetBlock},
+		};
+
+		// List of blocks used for the CRC32 calculation. Some blocks above are purposefully ignored.
+		// Every block that can be manually modified is in there
+		std::vector<std::pair<Byte*, uint64_t>> hashedFileBlocks{
+			{customPropertiesBlock, s_customProperties},
+
+			{movesetInfoBlock, s_movesetInfoBlock},
+			{tableBlock, s_tableBlock },
+			{movesetBlock, s_movesetBlock},
+		};
+
+		errcode = ExtractorUtils::WriteMovesetFile(filepath, tmp_filepath, customHeader, writtenFileBlocks, hashedFileBlocks, settings, progress);
+
+		if (errcode == ExtractionErrcode_Successful) {
 			DEBUG_LOG("- Saved moveset at '%S' -\n", filepath.c_str());
-
-			progress = 100;
-			// Extraction is over
-		}
-		else {
-			errcode = ExtractionErrcode_FileCreationErr;
 		}
+
+		progress = 100;
+		// Extraction is over
 	}
 
 
@@ -797,11 +746,11 @@ gameAddr ExtractorT8::GetCharacterAddress(uint8_t playerId)
 std::vector<gameAddr> ExtractorT8::GetCharacterAddresses()
 {
 	gameAddr playerAddress = m_game.ReadPtrPath("p1_addr");
-	std::vector<gameAddr> addresses;
+	// Failed reads return -1, same as ReadPtr() would
+	std::vector<gameAddr> addresses(m_gameInfo.characterCount, (gameAddr)-1);
 
-	for (uint8_t i = 0; i < m_gameInfo.characterCount; ++i) {
-		addresses.push_back(m_game.ReadPtr(playerAddress + 0x30 + (i * 0x8)));
-	}
+	// The player list is a contiguous array of ptrs, read all of it at once
+	m_game.ReadBytes(playerAddress + 0x30, addresses.data(), addresses.size() * sizeof(gameAddr));
 
 	return addresses;
 }
\ No newline at end of file
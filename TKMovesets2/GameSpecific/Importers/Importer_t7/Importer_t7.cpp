@@ -256,6 +256,9 @@ ImportationErrcode_ ImporterT7::_Import_FromT7(const TKMovesetHeader* header, By
 
 void ImporterT7::CleanupUnusedMovesets()
 {
+	// The player structures are scanned 8 bytes at a time, read their pages once
+	GameProcessReadCacheScope readCache(m_process);
+
 	gameAddr playerAddress = m_game.ReadPtrPath("p1_addr");
 	uint64_t playerstructSize = m_game.GetValue("playerstruct_size");
 	uint64_t motbinOffset = m_game.GetValue("motbin_offset");
@@ -356,21 +359,46 @@ bool ImporterT7::CanImport()
 		return false;
 	}
 
-	for (int i = 0; i < 2; ++i)
+	// Both players are checked at once, with one batch of reads per level of indirection
+	const int playerCount = 2;
+	gameAddr values[playerCount];
+	uint8_t animTypes[playerCount];
+	GameProcessReadRequest requests[playerCount];
+
+	for (int i = 0; i < playerCount; ++i)
 	{
 		gameAddr player = playerAddress + i * m_game.GetValue("playerstruct_size");
-		gameAddr currentMove = m_process.readInt64(player + m_game.GetValue("currmove"));
-		if (currentMove == 0 || currentMove == -1) {
+		requests[i] = { .addr = player + m_game.GetValue("currmove"), .buf = &values[i], .size = sizeof(gameAddr) };
+	}
+
+	// Current move, then its animation
+	for (uint64_t nextOffset : { 0x10, 0x0 })
+	{
+		if (!m_process.readBatch(requests, playerCount)) {
 			return false;
 		}
 
-		gameAddr animAddr = m_process.readInt64(currentMove + 0x10);
-		if (animAddr == 0 || animAddr == -1) {
-			return false;
+		for (int i = 0; i < playerCount; ++i)
+		{
+			if (values[i] == 0 || values[i] == -1) {
+				return false;
+			}
+			requests[i].addr = values[i] + nextOffset;
 		}
+	}
+
+	// Animation type
+	for (int i = 0; i < playerCount; ++i) {
+		requests[i].buf = &animTypes[i];
+		requests[i].size = sizeof(uint8_t);
+	}
+
+	if (!m_process.readBatch(requests, playerCount)) {
+		return false;
+	}
 
-		uint8_t animType = m_process.readInt8(animAddr);
-		if (animType != 0x64 && animType != 0xC8) {
+	for (int i = 0; i < playerCount; ++i) {
+		if (animTypes[i] != 0x64 && animTypes[i] != 0xC8) {
 			return false;
 		}
 	}
@@ -25,7 +25,7 @@ ImportationErrcode_ ImporterT7::_Import_FromTTT2(const TKMovesetHeader* header,
 	Byte* orig_moveset = moveset;
 
 	TKMovesetHeaderBlocks t7_offsets;
-	if (!MovesetConverter::TTT2ToT7().Convert(header, moveset, s_moveset, t7_offsets)) {
+	if (!MovesetConverter::CachedConvert<MovesetConverter::TTT2ToT7>(header, moveset, s_moveset, t7_offsets)) {
 		delete[] moveset;
 		return ImportationErrcode_AllocationErr;
 	}
@@ -144,7 +144,7 @@ ImportationErrcode_ ImporterT7::_Import_FromTREV(const TKMovesetHeader* header,
 	Byte* orig_moveset = moveset;
 
 	TKMovesetHeaderBlocks t7_offsets;
-	if (!MovesetConverter::TREVToT7().Convert(header, moveset, s_moveset, t7_offsets)) {
+	if (!MovesetConverter::CachedConvert<MovesetConverter::TREVToT7>(header, moveset, s_moveset, t7_offsets)) {
 		delete[] moveset;
 		return ImportationErrcode_AllocationErr;
 	}
@@ -264,7 +264,7 @@ ImportationErrcode_ ImporterT7::_Import_FromT6(const TKMovesetHeader* header, By
 	Byte* orig_moveset = moveset;
 
 	TKMovesetHeaderBlocks t7_offsets;
-	if (!MovesetConverter::T6ToT7().Convert(header, moveset, s_moveset, t7_offsets)) {
+	if (!MovesetConverter::CachedConvert<MovesetConverter::T6ToT7>(header, moveset, s_moveset, t7_offsets)) {
 		delete[] moveset;
 		return ImportationErrcode_AllocationErr;
 	}
@@ -385,13 +385,13 @@ ImportationErrcode_ ImporterT7::_Import_FromT5(const TKMovesetHeader* header, By
 
 	TKMovesetHeaderBlocks t7_offsets;
 	if (header->minorVersion == GameVersions::T5::DR_ONLINE) {
-		if (!MovesetConverter::T5DRToT7().Convert(header, moveset, s_moveset, t7_offsets)) {
+		if (!MovesetConverter::CachedConvert<MovesetConverter::T5DRToT7>(header, moveset, s_moveset, t7_offsets)) {
 			delete[] moveset;
 			return ImportationErrcode_AllocationErr;
 		}
 	}
 	else {
-		if (!MovesetConverter::T5ToT7().Convert(header, moveset, s_moveset, t7_offsets)) {
+		if (!MovesetConverter::CachedConvert<MovesetConverter::T5ToT7>(header, moveset, s_moveset, t7_offsets)) {
 			delete[] moveset;
 			return ImportationErrcode_AllocationErr;
 		}
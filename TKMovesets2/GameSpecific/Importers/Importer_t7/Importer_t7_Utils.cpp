@@ -1,10 +1,6 @@
 #include "Helpers.hpp"
 #include "Importer_t7_Utils.hpp"
 
-// Turns an index into an absolute address, or NULL (0) if index is -1
-# define FROM_INDEX(field, listStartAddr, type) (field = (field == -1 ? 0 : listStartAddr + (field * sizeof(type))))
-
-
 namespace T7ImportUtils
 {
 	void ConvertDisplayableMovelistOffsets(StructsT7::MvlHead* mvlHead)
@@ -63,94 +59,79 @@ namespace T7ImportUtils
 	void ConvertMovesetIndexes(Byte* moveset, gameAddr gameMoveset, const StructsT7_gameAddr::MovesetTable* table, const StructsT7::TKMovesetHeaderBlocks* offsets)
 	{
 		gameAddr blockOffset = gameMoveset + offsets->movesetBlock;
+		Byte* movesetBlock = moveset + offsets->movesetBlock;
 
 		for (auto& move : StructIterator<StructsT7_gameAddr::Move>(moveset, offsets->movesetBlock + table->move, table->moveCount))
 		{
 			move.name_addr += gameMoveset + offsets->nameBlock;
 			move.anim_name_addr += gameMoveset + offsets->nameBlock;
 			move.anim_addr += gameMoveset + offsets->animationBlock;
-
-			FROM_INDEX(move.cancel_addr, blockOffset + table->cancel, StructsT7::Cancel);
-			FROM_INDEX(move._0x28_cancel_addr, blockOffset + table->cancel, StructsT7::Cancel);
-			FROM_INDEX(move._0x38_cancel_addr, blockOffset + table->cancel, StructsT7::Cancel);
-			FROM_INDEX(move._0x48_cancel_addr, blockOffset + table->cancel, StructsT7::Cancel);
-			FROM_INDEX(move.hit_condition_addr, blockOffset + table->hitCondition, StructsT7::HitCondition);
-			FROM_INDEX(move.voicelip_addr, blockOffset + table->voiceclip, StructsT7::Voiceclip);
-			FROM_INDEX(move.extra_move_property_addr, blockOffset + table->extraMoveProperty, StructsT7::ExtraMoveProperty);
-			FROM_INDEX(move.move_start_extraprop_addr, blockOffset + table->moveBeginningProp, StructsT7::OtherMoveProperty);
-			FROM_INDEX(move.move_end_extraprop_addr, blockOffset + table->moveEndingProp, StructsT7::OtherMoveProperty);
 		}
+		Helpers::convertIndexesToPtrs(movesetBlock + table->move, sizeof(StructsT7_gameAddr::Move), table->moveCount, {
+			{ offsetof(StructsT7_gameAddr::Move, cancel_addr), blockOffset + table->cancel, sizeof(StructsT7::Cancel) },
+			{ offsetof(StructsT7_gameAddr::Move, _0x28_cancel_addr), blockOffset + table->cancel, sizeof(StructsT7::Cancel) },
+			{ offsetof(StructsT7_gameAddr::Move, _0x38_cancel_addr), blockOffset + table->cancel, sizeof(StructsT7::Cancel) },
+			{ offsetof(StructsT7_gameAddr::Move, _0x48_cancel_addr), blockOffset + table->cancel, sizeof(StructsT7::Cancel) },
+			{ offsetof(StructsT7_gameAddr::Move, hit_condition_addr), blockOffset + table->hitCondition, sizeof(StructsT7::HitCondition) },
+			{ offsetof(StructsT7_gameAddr::Move, voicelip_addr), blockOffset + table->voiceclip, sizeof(StructsT7::Voiceclip) },
+			{ offsetof(StructsT7_gameAddr::Move, extra_move_property_addr), blockOffset + table->extraMoveProperty, sizeof(StructsT7::ExtraMoveProperty) },
+			{ offsetof(StructsT7_gameAddr::Move, move_start_extraprop_addr), blockOffset + table->moveBeginningProp, sizeof(StructsT7::OtherMoveProperty) },
+			{ offsetof(StructsT7_gameAddr::Move, move_end_extraprop_addr), blockOffset + table->moveEndingProp, sizeof(StructsT7::OtherMoveProperty) },
+		});
 
 		// Convert projectile ptrs
-		for (auto& projectile : StructIterator<StructsT7_gameAddr::Projectile>(moveset, offsets->movesetBlock + table->projectile, table->projectileCount))
-		{
-			// One projectile actually has both at NULL for some reason ? todo : check
-			FROM_INDEX(projectile.cancel_addr, blockOffset + table->cancel, StructsT7::Cancel);
-			FROM_INDEX(projectile.hit_condition_addr, blockOffset + table->hitCondition, StructsT7::HitCondition);
-		}
-
-		// Convert cancel ptrs
-		for (auto& cancel : StructIterator<StructsT7_gameAddr::Cancel>(moveset, offsets->movesetBlock + table->cancel, table->cancelCount))
-		{
-			FROM_INDEX(cancel.requirements_addr, blockOffset + table->requirement, StructsT7::Requirement);
-			FROM_INDEX(cancel.extradata_addr, blockOffset + table->cancelExtradata, StructsT7::CancelExtradata);
-		}
-
-		// Convert groupe dcancel ptrs
-		for (auto& groupCancel : StructIterator<StructsT7_gameAddr::Cancel>(moveset, offsets->movesetBlock + table->groupCancel, table->groupCancelCount))
-		{
-			FROM_INDEX(groupCancel.requirements_addr, blockOffset + table->requirement, StructsT7::Requirement);
-			FROM_INDEX(groupCancel.extradata_addr, blockOffset + table->cancelExtradata, StructsT7::CancelExtradata);
-		}
+		// One projectile actually has both at NULL for some reason ? todo : check
+		Helpers::convertIndexesToPtrs(movesetBlock + table->projectile, sizeof(StructsT7_gameAddr::Projectile), table->projectileCount, {
+			{ offsetof(StructsT7_gameAddr::Projectile, cancel_addr), blockOffset + table->cancel, sizeof(StructsT7::Cancel) },
+			{ offsetof(StructsT7_gameAddr::Projectile, hit_condition_addr), blockOffset + table->hitCondition, sizeof(StructsT7::HitCondition) },
+		});
+
+		// Convert cancel & grouped cancel ptrs
+		const std::initializer_list<StructPtrField> cancelFields = {
+			{ offsetof(StructsT7_gameAddr::Cancel, requirements_addr), blockOffset + table->requirement, sizeof(StructsT7::Requirement) },
+			{ offsetof(StructsT7_gameAddr::Cancel, extradata_addr), blockOffset + table->cancelExtradata, sizeof(StructsT7::CancelExtradata) },
+		};
+		Helpers::convertIndexesToPtrs(movesetBlock + table->cancel, sizeof(StructsT7_gameAddr::Cancel), table->cancelCount, cancelFields);
+		Helpers::convertIndexesToPtrs(movesetBlock + table->groupCancel, sizeof(StructsT7_gameAddr::Cancel), table->groupCancelCount, cancelFields);
 
 		// Convert reaction ptrs
-		for (auto& reaction : StructIterator<StructsT7_gameAddr::Reactions>(moveset, offsets->movesetBlock + table->reactions, table->reactionsCount))
-		{
-			FROM_INDEX(reaction.front_pushback, blockOffset + table->pushback, StructsT7::Pushback);
-			FROM_INDEX(reaction.backturned_pushback, blockOffset + table->pushback, StructsT7::Pushback);
-			FROM_INDEX(reaction.left_side_pushback, blockOffset + table->pushback, StructsT7::Pushback);
-			FROM_INDEX(reaction.right_side_pushback, blockOffset + table->pushback, StructsT7::Pushback);
-			FROM_INDEX(reaction.front_counterhit_pushback, blockOffset + table->pushback, StructsT7::Pushback);
-			FROM_INDEX(reaction.downed_pushback, blockOffset + table->pushback, StructsT7::Pushback);
-			FROM_INDEX(reaction.block_pushback, blockOffset + table->pushback, StructsT7::Pushback);
-		}
+		Helpers::convertIndexesToPtrs(movesetBlock + table->reactions, sizeof(StructsT7_gameAddr::Reactions), table->reactionsCount, {
+			{ offsetof(StructsT7_gameAddr::Reactions, front_pushback), blockOffset + table->pushback, sizeof(StructsT7::Pushback) },
+			{ offsetof(StructsT7_gameAddr::Reactions, backturned_pushback), blockOffset + table->pushback, sizeof(StructsT7::Pushback) },
+			{ offsetof(StructsT7_gameAddr::Reactions, left_side_pushback), blockOffset + table->pushback, sizeof(StructsT7::Pushback) },
+			{ offsetof(StructsT7_gameAddr::Reactions, right_side_pushback), blockOffset + table->pushback, sizeof(StructsT7::Pushback) },
+			{ offsetof(StructsT7_gameAddr::Reactions, front_counterhit_pushback), blockOffset + table->pushback, sizeof(StructsT7::Pushback) },
+			{ offsetof(StructsT7_gameAddr::Reactions, downed_pushback), blockOffset + table->pushback, sizeof(StructsT7::Pushback) },
+			{ offsetof(StructsT7_gameAddr::Reactions, block_pushback), blockOffset + table->pushback, sizeof(StructsT7::Pushback) },
+		});
 
 		// Convert input sequence ptrs
-		for (auto& inputSequence : StructIterator<StructsT7_gameAddr::InputSequence>(moveset, offsets->movesetBlock + table->inputSequence, table->inputSequenceCount))
-		{
-			FROM_INDEX(inputSequence.input_addr, blockOffset + table->input, StructsT7::Input);
-		}
+		Helpers::convertIndexesToPtrs(movesetBlock + table->inputSequence, sizeof(StructsT7_gameAddr::InputSequence), table->inputSequenceCount, {
+			{ offsetof(StructsT7_gameAddr::InputSequence, input_addr), blockOffset + table->input, sizeof(StructsT7::Input) },
+		});
 
 		// Convert throwCameras ptrs
-		for (auto& throwCameras : StructIterator<StructsT7_gameAddr::ThrowCamera>(moveset, offsets->movesetBlock + table->throwCameras, table->throwCamerasCount))
-		{
-			FROM_INDEX(throwCameras.cameradata_addr, blockOffset + table->cameraData, StructsT7::CameraData);
-		}
+		Helpers::convertIndexesToPtrs(movesetBlock + table->throwCameras, sizeof(StructsT7_gameAddr::ThrowCamera), table->throwCamerasCount, {
+			{ offsetof(StructsT7_gameAddr::ThrowCamera, cameradata_addr), blockOffset + table->cameraData, sizeof(StructsT7::CameraData) },
+		});
 
 		// Convert hit conditions ptrs
-		for (auto& hitCondition : StructIterator<StructsT7_gameAddr::HitCondition>(moveset, offsets->movesetBlock + table->hitCondition, table->hitConditionCount))
-		{
-			FROM_INDEX(hitCondition.requirements_addr, blockOffset + table->requirement, StructsT7::Requirement);
-			FROM_INDEX(hitCondition.reactions_addr, blockOffset + table->reactions, StructsT7::Reactions);
-		}
+		Helpers::convertIndexesToPtrs(movesetBlock + table->hitCondition, sizeof(StructsT7_gameAddr::HitCondition), table->hitConditionCount, {
+			{ offsetof(StructsT7_gameAddr::HitCondition, requirements_addr), blockOffset + table->requirement, sizeof(StructsT7::Requirement) },
+			{ offsetof(StructsT7_gameAddr::HitCondition, reactions_addr), blockOffset + table->reactions, sizeof(StructsT7::Reactions) },
+		});
 
 		// Convert pushback ptrs
-		for (auto& pushback : StructIterator<StructsT7_gameAddr::Pushback>(moveset, offsets->movesetBlock + table->pushback, table->pushbackCount))
-		{
-			FROM_INDEX(pushback.extradata_addr, blockOffset + table->pushbackExtradata, StructsT7::PushbackExtradata);
-		}
-
-		// Convert move-start ptrs
-		for (auto& moveBeginProp : StructIterator<StructsT7_gameAddr::OtherMoveProperty>(moveset, offsets->movesetBlock + table->moveBeginningProp, table->moveBeginningPropCount))
-		{
-			FROM_INDEX(moveBeginProp.requirements_addr, blockOffset + table->requirement, StructsT7::Requirement);
-		}
-
-		// Convert move-end prop ptrs
-		for (auto& moveEndProp : StructIterator<StructsT7_gameAddr::OtherMoveProperty>(moveset, offsets->movesetBlock + table->moveEndingProp, table->moveEndingPropCount))
-		{
-			FROM_INDEX(moveEndProp.requirements_addr, blockOffset + table->requirement, StructsT7::Requirement);
-		}
+		Helpers::convertIndexesToPtrs(movesetBlock + table->pushback, sizeof(StructsT7_gameAddr::Pushback), table->pushbackCount, {
+			{ offsetof(StructsT7_gameAddr::Pushback, extradata_addr), blockOffset + table->pushbackExtradata, sizeof(StructsT7::PushbackExtradata) },
+		});
+
+		// Convert move-start & move-end prop ptrs
+		const std::initializer_list<StructPtrField> otherPropFields = {
+			{ offsetof(StructsT7_gameAddr::OtherMoveProperty, requirements_addr), blockOffset + table->requirement, sizeof(StructsT7::Requirement) },
+		};
+		Helpers::convertIndexesToPtrs(movesetBlock + table->moveBeginningProp, sizeof(StructsT7_gameAddr::OtherMoveProperty), table->moveBeginningPropCount, otherPropFields);
+		Helpers::convertIndexesToPtrs(movesetBlock + table->moveEndingProp, sizeof(StructsT7_gameAddr::OtherMoveProperty), table->moveEndingPropCount, otherPropFields);
 	}
 
 
@@ -0,0 +1,281 @@
+#include <algorithm>
+#include <fstream>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "helpers.hpp"
+#include "MovesetConverters.hpp"
+
+#include "constants.h"
+
+using namespace StructsT7;
+using MovesetConverter::ConversionCache::ConversionKey;
+
+struct CachedConversion
+{
+	ConversionKey key;
+	TKMovesetHeaderBlocks blocks;
+	std::vector<Byte> moveset;
+};
+
+// Written at the start of every cache file, everything in it is checked before the file's content is reused
+struct CacheFileHeader
+{
+	char magic[4] = { 'T', 'K', 'C', 'V' };
+	uint32_t converterVersion = MOVESET_CONVERTER_VERSION;
+	ConversionKey key;
+	uint64_t convertedSize;
+	uint32_t convertedCrc32;
+	uint32_t _padding = 0;
+	TKMovesetHeaderBlocks blocks;
+};
+
+// Ordered from least to most recently used. Entries are shared so that they can be copied without holding the lock.
+static std::vector<std::shared_ptr<const CachedConversion>> s_cachedConversions;
+// Imports of different players can run at the same time
+static std::mutex s_cacheMutex;
+
+// -- Static helpers -- //
+
+// The converter version is part of the name: files of older converters are never read and end up being deleted
+static std::string GetCacheFilename(const ConversionKey& key)
+{
+	return std::format(CONVERSION_CACHE_DIR "/{:08x}_{:08x}_{}_{}_{:x}_v{}.bin", key.crc32, key.sourceCrc32, key.gameId, key.minorVersion, key.s_moveset, MOVESET_CONVERTER_VERSION);
+}
+
+// Returns the cached entry matching [key] and marks it as the most recently used, or nullptr. Must be called with the lock held.
+static std::shared_ptr<const CachedConversion> FindInMemory(const ConversionKey& key)
+{
+	for (size_t i = 0; i < s_cachedConversions.size(); ++i)
+	{
+		if (s_cachedConversions[i]->key == key)
+		{
+			std::shared_ptr<const CachedConversion> entry = s_cachedConversions[i];
+			s_cachedConversions.erase(s_cachedConversions.begin() + i);
+			s_cachedConversions.push_back(entry);
+			return entry;
+		}
+	}
+	return nullptr;
+}
+
+// Must be called with the lock held
+static void AddToMemory(const std::shared_ptr<const CachedConversion>& entry)
+{
+	if (s_cachedConversions.size() >= CONVERSION_CACHE_MAX_ENTRIES) {
+		s_cachedConversions.erase(s_cachedConversions.begin());
+	}
+	s_cachedConversions.push_back(entry);
+}
+
+// File format: CacheFileHeader followed by the converted moveset
+static std::shared_ptr<const CachedConversion> LoadFromDisk(const ConversionKey& key)
+{
+	std::string filename = GetCacheFilename(key);
+	std::ifstream file(filename, std::ios::binary | std::ios::ate);
+
+	if (file.fail()) {
+		return nullptr;
+	}
+
+	uint64_t fileSize = file.tellg();
+	if (fileSize <= sizeof(CacheFileHeader)) {
+		return nullptr;
+	}
+
+	CacheFileHeader fileHeader;
+	file.seekg(0, std::ios::beg);
+	file.read((char*)&fileHeader, sizeof(CacheFileHeader));
+
+	if (file.fail() || memcmp(fileHeader.magic, "TKCV", 4) != 0 || fileHeader.converterVersion != MOVESET_CONVERTER_VERSION ||
+		fileHeader.key != key || fileHeader.convertedSize != fileSize - sizeof(CacheFileHeader)) {
+		DEBUG_ERR("Invalid cached conversion '%s'", filename.c_str());
+		return nullptr;
+	}
+
+	auto entry = std::make_shared<CachedConversion>();
+	try {
+		entry->moveset.resize(fileHeader.convertedSize);
+	}
+	catch (std::bad_alloc& _)
+	{
+		(void)_;
+		DEBUG_ERR("Failed to allocate %llu", fileHeader.convertedSize);
+		return nullptr;
+	}
+
+	file.read((char*)entry->moveset.data(), entry->moveset.size());
+	if (file.fail()) {
+		DEBUG_ERR("Failed to read cached conversion '%s'", filename.c_str());
+		return nullptr;
+	}
+	file.close();
+
+	if (Helpers::CalculateCrc32(entry->moveset.data(), entry->moveset.size()) != fileHeader.convertedCrc32) {
+		DEBUG_ERR("Corrupted cached conversion '%s'", filename.c_str());
+		return nullptr;
+	}
+
+	entry->key = key;
+	entry->blocks = fileHeader.blocks;
+
+	// Used as the last access date when deciding which files to delete
+	std::error_code ec;
+	std::filesystem::last_write_time(filename, std::filesystem::file_time_type::clock::now(), ec);
+
+	return entry;
+}
+
+static void SaveToDisk(const CachedConversion& entry)
+{
+	std::error_code ec;
+	std::filesystem::create_directories(CONVERSION_CACHE_DIR, ec);
+
+	CacheFileHeader fileHeader;
+	fileHeader.key = entry.key;
+	fileHeader.convertedSize = entry.moveset.size();
+	fileHeader.convertedCrc32 = Helpers::CalculateCrc32(entry.moveset.data(), entry.moveset.size());
+	fileHeader.blocks = entry.blocks;
+
+	// Written under a temporary name first: a file with the final name is always complete
+	std::string filename = GetCacheFilename(entry.key);
+	std::string tmp_filename = std::format("{}.{:x}.tmp", filename, std::hash<std::thread::id>{}(std::this_thread::get_id()));
+	{
+		std::ofstream file(tmp_filename, std::ios::binary);
+		if (file.fail()) {
+			DEBUG_ERR("Failed to open '%s' for writing", tmp_filename.c_str());
+			return;
+		}
+
+		file.write((const char*)&fileHeader, sizeof(CacheFileHeader));
+		file.write((const char*)entry.moveset.data(), entry.moveset.size());
+		file.close();
+
+		if (file.fail()) {
+			std::filesystem::remove(tmp_filename, ec);
+			return;
+		}
+	}
+
+	std::filesystem::rename(tmp_filename, filename, ec);
+	if (ec) {
+		DEBUG_ERR("Failed to rename '%s'", tmp_filename.c_str());
+		std::filesystem::remove(tmp_filename, ec);
+		return;
+	}
+
+	// Delete the least recently used files past the limit
+	std::vector<std::filesystem::directory_entry> files;
+	for (const auto& dirEntry : std::filesystem::directory_iterator(CONVERSION_CACHE_DIR, ec))
+	{
+		if (dirEntry.is_regular_file(ec)) {
+			files.push_back(dirEntry);
+		}
+	}
+
+	if (files.size() <= CONVERSION_CACHE_MAX_FILES) {
+		return;
+	}
+
+	std::sort(files.begin(), files.end(), [](const auto& a, const auto& b) {
+		return a.last_write_time() < b.last_write_time();
+	});
+
+	for (size_t i = 0; i + CONVERSION_CACHE_MAX_FILES < files.size(); ++i) {
+		std::filesystem::remove(files[i].path(), ec);
+	}
+}
+
+namespace MovesetConverter
+{
+	namespace ConversionCache
+	{
+		ConversionKey GetKey(const TKMovesetHeader* header, const Byte* moveset, uint64_t s_moveset)
+		{
+			// The converters read the block list from the header, the rest comes from the moveset
+			uint32_t sourceCrc32 = Helpers::crc32_update(0, (const Byte*)header + header->block_list, header->moveset_data_start - header->block_list);
+			sourceCrc32 = Helpers::crc32_update(sourceCrc32, moveset, s_moveset);
+
+			return {
+				.crc32 = header->crc32,
+				.sourceCrc32 = sourceCrc32,
+				.gameId = header->gameId,
+				.minorVersion = header->minorVersion,
+				.s_moveset = s_moveset
+			};
+		}
+
+		bool Find(const ConversionKey& key, Byte*& moveset_out, uint64_t& s_moveset_out, TKMovesetHeaderBlocks& blocks_out)
+		{
+			std::shared_ptr<const CachedConversion> entry;
+			{
+				std::lock_guard lock(s_cacheMutex);
+				entry = FindInMemory(key);
+			}
+
+			if (entry == nullptr)
+			{
+				entry = LoadFromDisk(key);
+				if (entry == nullptr) {
+					return false;
+				}
+
+				std::lock_guard lock(s_cacheMutex);
+				if (FindInMemory(key) == nullptr) {
+					AddToMemory(entry);
+				}
+			}
+
+			try {
+				Byte* new_moveset = new Byte[entry->moveset.size()];
+				memcpy(new_moveset, entry->moveset.data(), entry->moveset.size());
+
+				moveset_out = new_moveset;
+				s_moveset_out = entry->moveset.size();
+				blocks_out = entry->blocks;
+			}
+			catch (std::bad_alloc& _)
+			{
+				(void)_;
+				DEBUG_ERR("Failed to allocate %llu", (uint64_t)entry->moveset.size());
+				return false;
+			}
+
+			DEBUG_LOG("Reused cached conversion of moveset (crc32 %08x)\n", key.sourceCrc32);
+			return true;
+		}
+
+		void Store(const ConversionKey& key, const Byte* converted, uint64_t s_converted, const TKMovesetHeaderBlocks& blocks)
+		{
+			auto entry = std::make_shared<CachedConversion>();
+
+			try {
+				entry->key = key;
+				entry->blocks = blocks;
+				entry->moveset.assign(converted, converted + s_converted);
+			}
+			catch (std::bad_alloc& _)
+			{
+				// Not being able to cache a conversion doesn't prevent the importation
+				(void)_;
+				DEBUG_ERR("Failed to allocate %llu", s_converted);
+				return;
+			}
+
+			{
+				std::lock_guard lock(s_cacheMutex);
+				if (FindInMemory(key) != nullptr) {
+					// Already stored by another import of the same moveset
+					return;
+				}
+				AddToMemory(entry);
+			}
+
+			SaveToDisk(*entry);
+		}
+	};
+};
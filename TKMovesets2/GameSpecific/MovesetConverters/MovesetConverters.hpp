@@ -58,4 +58,49 @@ namespace MovesetConverter
 	public:
 		bool Convert(const TKMovesetHeader* header, Byte*& moveset, uint64_t& s_moveset, StructsT7::TKMovesetHeaderBlocks& blocks_out);
 	};
+
+	// Keeps the output of previous conversions, keyed by the source moveset's content and the converter version
+	// Entries live in memory and are also saved on disk so that they survive restarts
+	namespace ConversionCache
+	{
+		// Everything that has to match for a previous conversion to be reused
+		struct ConversionKey
+		{
+			// CRC32 stored in the header
+			uint32_t crc32;
+			// CRC32 of the block list and of the whole source moveset, names included. The header's CRC32 skips the name block and isn't validated on import.
+			uint32_t sourceCrc32;
+			uint16_t gameId;
+			uint16_t minorVersion;
+			// Size of the source moveset
+			uint64_t s_moveset;
+
+			bool operator==(const ConversionKey& other) const = default;
+		};
+
+		// Builds the key of a source moveset, must be called before the moveset is converted
+		ConversionKey GetKey(const TKMovesetHeader* header, const Byte* moveset, uint64_t s_moveset);
+		// Copies a previous conversion of the moveset in a newly allocated buffer (to delete[]). Returns false if there is none.
+		bool Find(const ConversionKey& key, Byte*& moveset_out, uint64_t& s_moveset_out, StructsT7::TKMovesetHeaderBlocks& blocks_out);
+		// Stores a copy of a freshly converted moveset
+		void Store(const ConversionKey& key, const Byte* converted, uint64_t s_converted, const StructsT7::TKMovesetHeaderBlocks& blocks);
+	};
+
+	// Converts the moveset with [T], or copies a previous conversion of the same moveset
+	// The cache stores what Convert() outputs: call this before any in-place modification of the converted moveset
+	template<class T> bool CachedConvert(const TKMovesetHeader* header, Byte*& moveset, uint64_t& s_moveset, StructsT7::TKMovesetHeaderBlocks& blocks_out)
+	{
+		const ConversionCache::ConversionKey key = ConversionCache::GetKey(header, moveset, s_moveset);
+
+		if (ConversionCache::Find(key, moveset, s_moveset, blocks_out)) {
+			return true;
+		}
+
+		if (!T().Convert(header, moveset, s_moveset, blocks_out)) {
+			return false;
+		}
+
+		ConversionCache::Store(key, moveset, s_moveset, blocks_out);
+		return true;
+	}
 };
\ No newline at end of file
@@ -146,7 +146,7 @@ static bool ConvertTREVToT7(const movesetInfo& mInfo, const TKMovesetHeader* ori
 
 	// Compress if needed
 	if (orig_header->compressionType != TKMovesetCompressionType_None) {
-		CompressionUtils::FILE::Moveset::Compress(new_filename, (TKMovesetCompressionType_)orig_header->compressionType);
+		CompressionUtils::FILE::Moveset::Compress(new_filename, orig_header->GetCompressionAlgorithm());
 	}
 
 	return true;
@@ -232,7 +232,7 @@ static bool ConvertTTT2ToT7(const movesetInfo& mInfo, const TKMovesetHeader* ori
 
 	// Compress if needed
 	if (orig_header->compressionType != TKMovesetCompressionType_None) {
-		CompressionUtils::FILE::Moveset::Compress(new_filename, (TKMovesetCompressionType_)orig_header->compressionType);
+		CompressionUtils::FILE::Moveset::Compress(new_filename, orig_header->GetCompressionAlgorithm());
 	}
 
 	return true;
@@ -318,7 +318,7 @@ static bool ConvertT6ToT7(const movesetInfo& mInfo, const TKMovesetHeader* orig_
 
 	// Compress if needed
 	if (orig_header->compressionType != TKMovesetCompressionType_None) {
-		CompressionUtils::FILE::Moveset::Compress(new_filename, (TKMovesetCompressionType_)orig_header->compressionType);
+		CompressionUtils::FILE::Moveset::Compress(new_filename, orig_header->GetCompressionAlgorithm());
 	}
 
 	return true;
@@ -404,7 +404,7 @@ static bool ConvertT5ToT7(const movesetInfo& mInfo, const TKMovesetHeader* orig_
 
 	// Compress if needed
 	if (orig_header->compressionType != TKMovesetCompressionType_None) {
-		CompressionUtils::FILE::Moveset::Compress(new_filename, (TKMovesetCompressionType_)orig_header->compressionType);
+		CompressionUtils::FILE::Moveset::Compress(new_filename, orig_header->GetCompressionAlgorithm());
 	}
 
 	return true;
@@ -490,7 +490,7 @@ static bool ConvertT5DRToT7(const movesetInfo& mInfo, const TKMovesetHeader* ori
 
 	// Compress if needed
 	if (orig_header->compressionType != TKMovesetCompressionType_None) {
-		CompressionUtils::FILE::Moveset::Compress(new_filename, (TKMovesetCompressionType_)orig_header->compressionType);
+		CompressionUtils::FILE::Moveset::Compress(new_filename, orig_header->GetCompressionAlgorithm());
 	}
 
 	return true;
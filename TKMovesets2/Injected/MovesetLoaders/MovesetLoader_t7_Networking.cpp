@@ -295,7 +295,7 @@ void MovesetLoaderT7::OnPacketReceive(CSteamID senderId, const Byte* packetBuf,
 static bool CompressMovesetLzma(Byte*& moveset_out, uint64_t& size_out)
 {
 	const TKMovesetHeader* current_header = (TKMovesetHeader*)moveset_out;
-	if (current_header->compressionType == TKMovesetCompressionType_LZMA) {
+	if (current_header->GetCompressionAlgorithm() == TKMovesetCompressionType_LZMA) {
 		DEBUG_LOG("Local moveset is already LZMA, sending as is.\n");
 		return false;
 	}
@@ -311,6 +311,12 @@ static bool CompressMovesetLzma(Byte*& moveset_out, uint64_t& size_out)
 		moveset_size = current_header->moveset_data_start + current_header->moveset_data_size;
 		moveset = CompressionUtils::RAW::Moveset::DecompressWithHeader(moveset, compressed_data_size, moveset_size);
 
+		if (moveset == nullptr) {
+			// Allocation failure: the moveset is left as is, it can still be decompressed on the other end
+			DEBUG_LOG("Failed to decompress local moveset, sending as is.\n");
+			return false;
+		}
+
 		DEBUG_LOG("Local moveset was compressed, its decompressed size is %llu bytes.\n", moveset_size);
 	}
 
@@ -228,9 +228,9 @@ void MainWindow::Update()
 				break;
 			case NAV__MENU_EDITION:
 				{
-					movesetInfo* moveset = m_editionMenu.Render(m_storage);
+					auto moveset = m_editionMenu.Render(m_storage);
 					if (moveset != nullptr) {
-						LoadMovesetEditor(moveset);
+						LoadMovesetEditor(moveset.get());
 					}
 				}
 				break;
@@ -283,7 +283,6 @@ void MainWindow::Update()
 	// -- Rendering end -- //
 	{
 		// Cleanup stuff that we really don't want to clean up during Render()
-		m_storage.CleanupUnusedMovesetInfos();
 		m_extractor.FreeExpiredFactoryClasses();
 		m_importer.FreeExpiredFactoryClasses();
 		m_sharedMem.FreeExpiredFactoryClasses();
@@ -151,7 +151,7 @@ void Submenu_Edition::ExtractAllAnimations()
 	m_animExtraction.extracting = false;
 }
 
-movesetInfo* Submenu_Edition::Render(LocalStorage& storage)
+std::shared_ptr<movesetInfo> Submenu_Edition::Render(LocalStorage& storage)
 {
 	ImGuiExtra::RenderTextbox(_("edition.explanation"));
 
@@ -160,12 +160,13 @@ movesetInfo* Submenu_Edition::Render(LocalStorage& storage)
 		// Extract all movesets
 		if (ImGuiExtra::RenderButtonEnabled(_("edition.extract_animations"), !m_animExtraction.extracting))
 		{
-			m_animExtraction.extractionControl.statuses = std::vector<s_extractionStatus>(storage.extractedMovesets.size());
+			auto movesets = storage.GetMovesetList();
+			m_animExtraction.extractionControl.statuses = std::vector<s_extractionStatus>(movesets->movesets.size());
 
 			m_animExtraction.movesets.clear();
 
-			// Createe a copy of extractedMovesets so that there's no problem if it changes while we're extracting stuff
-			for (auto& item : storage.extractedMovesets) {
+			// Createe a copy of the moveset infos so that there's no problem if they get freed while we're extracting stuff
+			for (auto& item : movesets->movesets) {
 				m_animExtraction.movesets.push_back(*item);
 			}
 
@@ -303,7 +304,7 @@ movesetInfo* Submenu_Edition::Render(LocalStorage& storage)
 
 	ImGui::SeparatorText(_("edition.select_moveset"));
 
-	movesetInfo* movesetToLoad = nullptr;
+	std::shared_ptr<movesetInfo> movesetToLoad;
 
 	auto availableSpace = ImGui::GetContentRegionAvail();
 	ImVec2 tableSize = ImVec2(0, availableSpace.y);
@@ -315,20 +316,20 @@ movesetInfo* Submenu_Edition::Render(LocalStorage& storage)
 	const unsigned int rowCount = 9;
 #endif
 	if (ImGui::BeginTable("MovesetEditionList", rowCount, ImGuiTableFlags_SizingFixedSame | ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_ScrollY
-		| ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable, tableSize))
+		| ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable | ImGuiTableFlags_Sortable, tableSize))
 	{
-		ImGui::TableSetupColumn("##", 0, 5.0f);
-		ImGui::TableSetupColumn(_("moveset.origin"));
-		ImGui::TableSetupColumn(_("moveset.target_character"));
-		ImGui::TableSetupColumn(_("moveset.date"));
+		ImGui::TableSetupColumn("##", ImGuiTableColumnFlags_DefaultSort, 5.0f, movesetListSort_Name);
+		ImGui::TableSetupColumn(_("moveset.origin"), 0, 0.0f, movesetListSort_Origin);
+		ImGui::TableSetupColumn(_("moveset.target_character"), 0, 0.0f, movesetListSort_TargetCharacter);
+		ImGui::TableSetupColumn(_("moveset.date"), 0, 0.0f, movesetListSort_Date);
 #ifdef BUILD_TYPE_DEBUG
-		ImGui::TableSetupColumn(_("moveset.extraction_date"));
+		ImGui::TableSetupColumn(_("moveset.extraction_date"), ImGuiTableColumnFlags_NoSort);
 #endif
-		ImGui::TableSetupColumn(_("moveset.size"));
-		ImGui::TableSetupColumn(_("moveset.convert"));
-		ImGui::TableSetupColumn(_("moveset.duplicate"));
-		ImGui::TableSetupColumn(_("moveset.rename"));
-		ImGui::TableSetupColumn(_("moveset.edit"));
+		ImGui::TableSetupColumn(_("moveset.size"), 0, 0.0f, movesetListSort_Size);
+		ImGui::TableSetupColumn(_("moveset.convert"), ImGuiTableColumnFlags_NoSort);
+		ImGui::TableSetupColumn(_("moveset.duplicate"), ImGuiTableColumnFlags_NoSort);
+		ImGui::TableSetupColumn(_("moveset.rename"), ImGuiTableColumnFlags_NoSort);
+		ImGui::TableSetupColumn(_("moveset.edit"), ImGuiTableColumnFlags_NoSort);
 		ImGui::TableHeadersRow();
 
 		ImGui::PushID(&storage);
@@ -337,76 +338,91 @@ movesetInfo* Submenu_Edition::Render(LocalStorage& storage)
 		ImDrawList* drawlist = ImGui::GetWindowDrawList();
 		auto windowPos = ImGui::GetWindowPos();
 
-		// Yes, we don't use an iterator here because the vector might actually change size mid-iteration
-		for (size_t i = 0; i < storage.extractedMovesets.size(); ++i)
-		{
-			// moveset is guaranteed not to be freed until after this loop
-			movesetInfo* moveset = storage.extractedMovesets[i];
+		// The list we get is never modified, and keeps the infos it points to alive until we're done with it
+		auto movesets = storage.GetMovesetList();
 
-			ImGui::TableNextRow();
-			ImGui::TableNextColumn();
+		// The list comes with every sorted order already built, and only the visible rows are ever looked at
+		movesetListSort_ sort = movesetListSort_Name;
+		bool descending = false;
+		if (ImGuiTableSortSpecs* sortSpecs = ImGui::TableGetSortSpecs(); sortSpecs != nullptr && sortSpecs->SpecsCount != 0) {
+			sort = (movesetListSort_)sortSpecs->Specs[0].ColumnUserID;
+			descending = sortSpecs->Specs[0].SortDirection == ImGuiSortDirection_Descending;
+		}
 
-			if (moveset->color != 0)
+		ImGuiListClipper clipper;
+		clipper.Begin((int)movesets->movesets.size());
+		while (clipper.Step())
+		{
+			for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
 			{
-				// Draw BG
-				ImVec2 drawStart = windowPos + ImGui::GetCursorPos();
-				drawStart.y -= ImGui::GetScrollY();
-				ImVec2 drawArea = ImVec2(availableSpace.x, ImGui::GetFrameHeight());
-				drawlist->AddRectFilled(drawStart, drawStart + drawArea, moveset->color);
-			}
-
-			ImGui::TextUnformatted(moveset->name.c_str());
-
-			ImGui::TableNextColumn();
-			if (moveset->origin == "INVALID") {
-				// Badly formatted file. Display it, but mention it is invalid
-				ImGui::TextUnformatted(_("moveset.invalid"));
-			}
-			else {
-				ImGui::TextUnformatted(moveset->origin.c_str());
+				const std::shared_ptr<movesetInfo>& movesetPtr = movesets->GetSorted(sort, descending, row);
+				movesetInfo* moveset = movesetPtr.get();
 
+				ImGui::TableNextRow();
 				ImGui::TableNextColumn();
-				ImGui::TextUnformatted(moveset->target_character.c_str());
-
-				ImGui::TableNextColumn();
-				ImGui::TextUnformatted(moveset->date_str.c_str());
-
-#ifdef BUILD_TYPE_DEBUG
-				ImGui::TableNextColumn();
-				ImGui::TextUnformatted(moveset->extraction_date_str.c_str());
-#endif
 
-				ImGui::TableNextColumn();
-				ImGui::TextUnformatted(moveset->sizeStr.c_str());
+				if (moveset->color != 0)
+				{
+					// Draw BG
+					ImVec2 drawStart = windowPos + ImGui::GetCursorPos();
+					drawStart.y -= ImGui::GetScrollY();
+					ImVec2 drawArea = ImVec2(availableSpace.x, ImGui::GetFrameHeight());
+					drawlist->AddRectFilled(drawStart, drawStart + drawArea, moveset->color);
+				}
 
-				ImGui::PushID(moveset->filename.c_str());
+				ImGui::TextUnformatted(moveset->name.c_str());
 
 				ImGui::TableNextColumn();
-				if (ImGui::Button(_("moveset.convert"))) {
-					m_actionTarget = *moveset;
-					m_conversionPopup = true;
+				if (moveset->origin == "INVALID") {
+					// Badly formatted file. Display it, but mention it is invalid
+					ImGui::TextUnformatted(_("moveset.invalid"));
 				}
+				else {
+					ImGui::TextUnformatted(moveset->origin.c_str());
 
-				ImGui::TableNextColumn();
-				if (ImGui::Button(_("moveset.duplicate"))) {
-					DuplicateMoveset(moveset->filename);
-				}
+					ImGui::TableNextColumn();
+					ImGui::TextUnformatted(moveset->target_character.c_str());
 
-				ImGui::TableNextColumn();
-				if (ImGui::Button(_("moveset.rename"))) {
-					m_actionTarget = *moveset;
-					strcpy_s(m_newName, sizeof(m_newName), moveset->name.c_str());
-					m_renamePopup = true;
-					currentErr = RenameErrcode_NoErr;
-				}
+					ImGui::TableNextColumn();
+					ImGui::TextUnformatted(moveset->date_str.c_str());
 
-				ImGui::TableNextColumn();
-				ImGui::PushStyleColor(ImGuiCol_Button, FORM_INPUT_HEX);
-				if (ImGuiExtra::RenderButtonEnabled(_("moveset.edit"), moveset->editable)) {
-					movesetToLoad = moveset;
+#ifdef BUILD_TYPE_DEBUG
+					ImGui::TableNextColumn();
+					ImGui::TextUnformatted(moveset->extraction_date_str.c_str());
+#endif
+
+					ImGui::TableNextColumn();
+					ImGui::TextUnformatted(moveset->sizeStr.c_str());
+
+					ImGui::PushID(moveset->filename.c_str());
+
+					ImGui::TableNextColumn();
+					if (ImGui::Button(_("moveset.convert"))) {
+						m_actionTarget = *moveset;
+						m_conversionPopup = true;
+					}
+
+					ImGui::TableNextColumn();
+					if (ImGui::Button(_("moveset.duplicate"))) {
+						DuplicateMoveset(moveset->filename);
+					}
+
+					ImGui::TableNextColumn();
+					if (ImGui::Button(_("moveset.rename"))) {
+						m_actionTarget = *moveset;
+						strcpy_s(m_newName, sizeof(m_newName), moveset->name.c_str());
+						m_renamePopup = true;
+						currentErr = RenameErrcode_NoErr;
+					}
+
+					ImGui::TableNextColumn();
+					ImGui::PushStyleColor(ImGuiCol_Button, FORM_INPUT_HEX);
+					if (ImGuiExtra::RenderButtonEnabled(_("moveset.edit"), moveset->editable)) {
+						movesetToLoad = movesetPtr;
+					}
+					ImGui::PopStyleColor();
+					ImGui::PopID();
 				}
-				ImGui::PopStyleColor();
-				ImGui::PopID();
 			}
 		}
 		ImGui::PopID();
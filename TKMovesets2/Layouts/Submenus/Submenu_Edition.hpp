@@ -50,7 +50,7 @@ private:
 	// Render the popup used for moveset conversion
 	void RenderConversionPopup();
 public:
-	movesetInfo* Render(LocalStorage& storage);
+	std::shared_ptr<movesetInfo> Render(LocalStorage& storage);
 
 	~Submenu_Edition();
 };
\ No newline at end of file
@@ -29,6 +29,8 @@ Submenu_Extract::Submenu_Extract()
 
 	m_extractUnsupportedMotas = false;
 
+	m_reuseExistingFile = true;
+
 	m_compressionIndex = CompressionUtils::GetDefaultCompressionSetting();
 }
 
@@ -50,6 +52,14 @@ ExtractSettings Submenu_Extract::GetExtractionSettings()
 		settings |= ExtractSettings_DisplayableMovelist;
 	}
 
+	if (m_reuseExistingFile) {
+		settings |= ExtractSettings_ReuseExistingFile;
+	}
+
+	if (m_recordSnapshot) {
+		settings |= ExtractSettings_RecordSnapshot;
+	}
+
 	for (uint8_t i = 0; i < _countof(m_motaExport); ++i) {
 		if (m_motaExport[i]) {
 			settings |= ((uint64_t)1 << i);
@@ -83,6 +93,10 @@ void Submenu_Extract::RenderSettingsPopup()
 	ImGui::NewLine();
 	ImGui::SeparatorText(_("extraction.settings.other"));
 	ImGui::Checkbox(_("extraction.settings.displayable_movelist"), &m_extractDisplayableMovelist);
+	ImGui::Checkbox(_("extraction.settings.reuse_existing_file"), &m_reuseExistingFile);
+#ifdef BUILD_TYPE_DEBUG
+	ImGui::Checkbox("Record snapshot", &m_recordSnapshot);
+#endif
 
 	ImGui::TextUnformatted(_("extraction.settings.compress_moveset"));
 	if (ImGui::BeginCombo("##", m_compressionIndex == 0 ? _("extraction.settings.compression_type.none") : CompressionUtils::GetCompressionSetting(m_compressionIndex).name))
@@ -193,18 +207,30 @@ void Submenu_Extract::Render(GameExtract& extractorHelper)
 			extractorHelper.QueueCharacterExtraction(-1, GetExtractionSettings());
 		}
 
-		if (extractorHelper.progress > 0) {
+		uint8_t progress = extractorHelper.GetProgress();
+		if (progress > 0) {
 			// Progress text.
 			ImGui::SameLine();
-			if (extractorHelper.progress == 100) {
+			if (progress == 100) {
 				ImGui::TextColored(ImVec4(0, 1.0f, 0, 1), _("extraction.progress_done"));
 			}
 			else {
 				if (busy) {
-					ImGui::Text(_("extraction.progress"), extractorHelper.progress);
+					ImGui::Text(_("extraction.progress"), progress);
+
+					// Detail the progress of every extraction when running multiple ones
+					std::vector<uint8_t> jobsProgress = extractorHelper.GetJobsProgress();
+					if (jobsProgress.size() > 1) {
+						std::string jobsProgressText;
+						for (uint8_t jobProgress : jobsProgress) {
+							jobsProgressText += std::format(" {}%", jobProgress);
+						}
+						ImGui::SameLine();
+						ImGui::TextDisabled("(%s )", jobsProgressText.c_str());
+					}
 				}
 				else {
-					ImGui::TextColored(ImVec4(1.0f, 0, 0, 1), _("extraction.progress_error"), extractorHelper.progress);
+					ImGui::TextColored(ImVec4(1.0f, 0, 0, 1), _("extraction.progress_error"), progress);
 				}
 			}
 		}
@@ -258,11 +284,11 @@ void Submenu_Extract::Render(GameExtract& extractorHelper)
 		ImDrawList* drawlist = ImGui::GetWindowDrawList();
 		auto windowPos = ImGui::GetWindowPos();
 
-		// Yes, we don't use an iterator here because the vector might actually change size mid-iteration
-		for (size_t i = 0; i < extractorHelper.storage->extractedMovesets.size(); ++i)
+		// The list we get is never modified, and keeps the infos it points to alive until we're done with it
+		auto movesets = extractorHelper.storage->GetMovesetList();
+		for (auto& movesetPtr : movesets->movesets)
 		{
-			// moveset is guaranteed not to be freed until after this loop
-			movesetInfo* moveset = extractorHelper.storage->extractedMovesets[i];
+			movesetInfo* moveset = movesetPtr.get();
 
 			ImGui::TableNextRow();
 			ImGui::TableNextColumn();
@@ -13,6 +13,10 @@ private:
 	bool m_extractDisplayableMovelist;
 	// Whether to extract unsupported MOTA formats (used for debug purposes)
 	bool m_extractUnsupportedMotas;
+	// Whether to copy the unchanged parts of the moveset being overwritten instead of compressing them again
+	bool m_reuseExistingFile;
+	// Whether to record the extraction into a snapshot that can be replayed without the game (used for debug purposes)
+	bool m_recordSnapshot = false;
 
 	// Type of compression to apply to the moveset
 	unsigned int m_compressionIndex = 0;
@@ -130,13 +130,13 @@ void Submenu_Import::Render(GameImport& importerHelper)
 
 	ImGui::SeparatorText(_("importation.select_moveset"));
 	if (ImGui::BeginTable("MovesetImportationList", 5, ImGuiTableFlags_SizingFixedSame | ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_ScrollY
-		| ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable | ImGuiTableFlags_NoHostExtendY, tableSize))
+		| ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable | ImGuiTableFlags_NoHostExtendY | ImGuiTableFlags_Sortable, tableSize))
 	{
-		ImGui::TableSetupColumn("##", 0, 5.0f);
-		ImGui::TableSetupColumn(_("moveset.origin"));
-		ImGui::TableSetupColumn(_("moveset.target_character"));
-		ImGui::TableSetupColumn(_("moveset.date"));
-		ImGui::TableSetupColumn(_("moveset.import"));
+		ImGui::TableSetupColumn("##", ImGuiTableColumnFlags_DefaultSort, 5.0f, movesetListSort_Name);
+		ImGui::TableSetupColumn(_("moveset.origin"), 0, 0.0f, movesetListSort_Origin);
+		ImGui::TableSetupColumn(_("moveset.target_character"), 0, 0.0f, movesetListSort_TargetCharacter);
+		ImGui::TableSetupColumn(_("moveset.date"), 0, 0.0f, movesetListSort_Date);
+		ImGui::TableSetupColumn(_("moveset.import"), ImGuiTableColumnFlags_NoSort);
 		ImGui::TableHeadersRow();
 
 		ImGui::PushID(&importerHelper);
@@ -145,48 +145,63 @@ void Submenu_Import::Render(GameImport& importerHelper)
 		ImDrawList* drawlist = ImGui::GetWindowDrawList();
 		auto windowPos = ImGui::GetWindowPos();
 
-		// Yes, we don't use an iterator here because the vector might actually change size mid-iteration
-		for (size_t i = 0; i < importerHelper.storage->extractedMovesets.size(); ++i)
-		{
-			// moveset is guaranteed not to be freed until after this loop
-			movesetInfo* moveset = importerHelper.storage->extractedMovesets[i];
+		// The list we get is never modified, and keeps the infos it points to alive until we're done with it
+		auto movesets = importerHelper.storage->GetMovesetList();
 
-			ImGui::TableNextRow();
-			ImGui::TableNextColumn();
+		// The list comes with every sorted order already built, and only the visible rows are ever looked at
+		movesetListSort_ sort = movesetListSort_Name;
+		bool descending = false;
+		if (ImGuiTableSortSpecs* sortSpecs = ImGui::TableGetSortSpecs(); sortSpecs != nullptr && sortSpecs->SpecsCount != 0) {
+			sort = (movesetListSort_)sortSpecs->Specs[0].ColumnUserID;
+			descending = sortSpecs->Specs[0].SortDirection == ImGuiSortDirection_Descending;
+		}
 
-			if (moveset->color != 0)
+		ImGuiListClipper clipper;
+		clipper.Begin((int)movesets->movesets.size());
+		while (clipper.Step())
+		{
+			for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
 			{
-				// Draw BG
-				ImVec2 drawStart = windowPos + ImGui::GetCursorPos();
-				drawStart.y -= ImGui::GetScrollY();
-				ImVec2 drawArea = ImVec2(availableSpace.x, ImGui::GetFrameHeight());
-				drawlist->AddRectFilled(drawStart, drawStart + drawArea, moveset->color);
-			}
+				const std::shared_ptr<movesetInfo>& movesetPtr = movesets->GetSorted(sort, descending, row);
+				movesetInfo* moveset = movesetPtr.get();
 
-			ImGui::TextUnformatted(moveset->name.c_str());
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
 
-			ImGui::TableNextColumn();
-			if (moveset->origin == "INVALID") {
-				// Badly formatted file. Display it, but mention it is invalid
-				ImGui::TextUnformatted(_("moveset.invalid"));
-			}
-			else {
-				ImGui::TextUnformatted(moveset->origin.c_str());
+				if (moveset->color != 0)
+				{
+					// Draw BG
+					ImVec2 drawStart = windowPos + ImGui::GetCursorPos();
+					drawStart.y -= ImGui::GetScrollY();
+					ImVec2 drawArea = ImVec2(availableSpace.x, ImGui::GetFrameHeight());
+					drawlist->AddRectFilled(drawStart, drawStart + drawArea, moveset->color);
+				}
 
-				ImGui::TableNextColumn();
-				ImGui::TextUnformatted(moveset->target_character.c_str());
+				ImGui::TextUnformatted(moveset->name.c_str());
 
 				ImGui::TableNextColumn();
-				ImGui::TextUnformatted(moveset->date_str.c_str());
+				if (moveset->origin == "INVALID") {
+					// Badly formatted file. Display it, but mention it is invalid
+					ImGui::TextUnformatted(_("moveset.invalid"));
+				}
+				else {
+					ImGui::TextUnformatted(moveset->origin.c_str());
 
-				ImGui::TableNextColumn();
-				ImGui::PushID(moveset->filename.c_str());
+					ImGui::TableNextColumn();
+					ImGui::TextUnformatted(moveset->target_character.c_str());
 
-				bool canImportMoveset = canImport && importerHelper.currentGame->SupportsGameImport(moveset->gameId);
-				if (ImGuiExtra::RenderButtonEnabled(_("moveset.import"), canImportMoveset)) {
-					importerHelper.QueueCharacterImportation(moveset->filename, GetImportationSettings());
+					ImGui::TableNextColumn();
+					ImGui::TextUnformatted(moveset->date_str.c_str());
+
+					ImGui::TableNextColumn();
+					ImGui::PushID(moveset->filename.c_str());
+
+					bool canImportMoveset = canImport && importerHelper.currentGame->SupportsGameImport(moveset->gameId);
+					if (ImGuiExtra::RenderButtonEnabled(_("moveset.import"), canImportMoveset)) {
+						importerHelper.QueueCharacterImportation(moveset->filename, GetImportationSettings());
+					}
+					ImGui::PopID();
 				}
-				ImGui::PopID();
 			}
 		}
 		ImGui::PopID();
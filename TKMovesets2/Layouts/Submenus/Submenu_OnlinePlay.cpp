@@ -45,11 +45,11 @@ void Submenu_OnlinePlay::RenderMovesetList(bool canSelectMoveset)
 		ImDrawList* drawlist = ImGui::GetWindowDrawList();
 		auto windowPos = ImGui::GetWindowPos();
 
-		// Yes, we don't use an iterator here because the vector might actually change size mid-iteration
-		for (size_t i = 0; i < gameHelper->storage->extractedMovesets.size(); ++i)
+		// The list we get is never modified, and keeps the infos it points to alive until we're done with it
+		auto movesets = gameHelper->storage->GetMovesetList();
+		for (auto& movesetPtr : movesets->movesets)
 		{
-			// Moveset is guaranteed not to be freed until after this loop
-			movesetInfo* moveset = gameHelper->storage->extractedMovesets[i];
+			movesetInfo* moveset = movesetPtr.get();
 
 			if (moveset->origin == "INVALID") {
 				continue;
@@ -236,7 +236,7 @@ void Submenu_OnlinePlay::Render()
 		// Player info
 		std::vector<movesetInfo> selectedMovesetList_copy = gameHelper->displayedMovesets;
 		auto rowWidth = availableSpace.x / 3;
-		bool movesetListNotEmpty = gameHelper->storage->extractedMovesets.size();
+		bool movesetListNotEmpty = gameHelper->storage->GetMovesetList()->movesets.size() != 0;
 		const unsigned int playerid = 0;
 
 		auto p = ImGui::GetCursorPos();
@@ -43,11 +43,11 @@ void Submenu_PersistentPlay::RenderMovesetList(bool canSelectMoveset)
 		ImDrawList* drawlist = ImGui::GetWindowDrawList();
 		auto windowPos = ImGui::GetWindowPos();
 
-		// Yes, we don't use an iterator here because the vector might actually change size mid-iteration
-		for (size_t i = 0; i < gameHelper->storage->extractedMovesets.size(); ++i)
+		// The list we get is never modified, and keeps the infos it points to alive until we're done with it
+		auto movesets = gameHelper->storage->GetMovesetList();
+		for (auto& movesetPtr : movesets->movesets)
 		{
-			// Moveset is guaranteed not to be freed until after this loop
-			movesetInfo* moveset = gameHelper->storage->extractedMovesets[i];
+			movesetInfo* moveset = movesetPtr.get();
 
 			if (moveset->origin == "INVALID") {
 				continue;
@@ -230,7 +230,7 @@ void Submenu_PersistentPlay::Render()
 		// List of players with their associated moveset
 		std::vector<movesetInfo> selectedMovesetList_copy = gameHelper->displayedMovesets;
 		auto rowWidth = availableSpace.x / 3;
-		bool movesetListNotEmpty = gameHelper->storage->extractedMovesets.size();
+		bool movesetListNotEmpty = gameHelper->storage->GetMovesetList()->movesets.size() != 0;
 		for (unsigned int playerid = 0; playerid < playerCount; ++playerid)
 		{
 			auto p = ImGui::GetCursorPos();
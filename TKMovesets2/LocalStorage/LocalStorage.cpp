@@ -1,6 +1,8 @@
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <sys/stat.h>
+#include <windows.h>
 
 #include "LocalStorage.hpp"
 #include "Localization.hpp"
@@ -20,74 +22,437 @@ static int getMovesetColor(MovesetFlags flags)
 	return 0;
 }
 
-// Reads a movest in order to fetch its header informations such as character name, version, etc. Can return null if errors are encountered.
-static movesetInfo* fetchMovesetInformations(const std::wstring& filename)
+// Builds the moveset informations from its header. Can return null if the header is invalid.
+static movesetInfo* buildMovesetInformations(const std::wstring& filename, const TKMovesetHeader& movesetInfos, uint64_t totalSize, time_t modificationDate)
+{
+	if (!movesetInfos.ValidateHeader() ||
+		Helpers::isHeaderStringMalformated(movesetInfos.version_string, sizeof(movesetInfos.version_string)) ||
+		Helpers::isHeaderStringMalformated(movesetInfos.origin, sizeof(movesetInfos.origin)) ||
+		Helpers::isHeaderStringMalformated(movesetInfos.target_character, sizeof(movesetInfos.target_character))) {
+		// File malformated
+		return nullptr;
+	}
+
+	// Build crc32 str string
+	std::string crc32Str;
+	{
+		char buffer[9];
+		sprintf_s(buffer, 9, "%08X", movesetInfos.crc32);
+		crc32Str = buffer;
+	}
+
+	return new movesetInfo{
+		.color = getMovesetColor(movesetInfos.flags),
+		.filename = filename,
+		.name = Helpers::getMovesetNameFromFilename(filename),
+		.wname = Helpers::getMovesetWNameFromFilename(filename),
+		.origin = movesetInfos.origin,
+		.target_character = movesetInfos.target_character,
+		.original_character = movesetInfos.GetOrigCharacterName(),
+		.version_string = std::string(movesetInfos.version_string),
+		.date = movesetInfos.date,
+		.date_str = Helpers::formatDateTime(movesetInfos.date),
+		.extraction_date_str = Helpers::formatDateTime(movesetInfos.extraction_date),
+		.size = totalSize,
+		.sizeStr = std::format("{:.2f} {}", (float)totalSize / 1000 / 1000, _("moveset.size_mb")),
+		.hash = crc32Str,
+		.extractionDate = movesetInfos.extraction_date,
+		.modificationDate = modificationDate,
+		.gameId = movesetInfos.gameId,
+		.minorVersion = movesetInfos.minorVersion,
+		.modified = (movesetInfos.flags & MovesetFlags_MovesetModified) != 0,
+		.editable = Games::IsGameEditable(movesetInfos.gameId, movesetInfos.minorVersion),
+		.onlineImportable = totalSize < ONLINE_MOVESET_MAX_SIZE_BYTES,
+		.is_valid = true
+	};
+}
+
+// Reads a movest in order to fetch its header informations such as character name, version, etc. Returns false if the file could not be read.
+static bool fetchMovesetHeader(const std::wstring& filename, movesetIndexEntry& entry_out)
 {
 	std::ifstream file;
 	file.open(filename, std::ios::binary);
 
-	if (!file.fail())
+	if (file.fail()) {
+		return false;
+	}
+
+	file.read((char*)&entry_out.header, sizeof(TKMovesetHeader));
+
+	size_t readBytes = file.gcount();
+	file.seekg(0, std::ios::end);
+	entry_out.size = file.tellg();
+	file.close();
+
+	struct _stat buffer;
+	// _wstat() the file to read modification time
+	_wstat(filename.c_str(), &buffer);
+	entry_out.modificationDate = buffer.st_mtime;
+	entry_out.is_valid = readBytes == sizeof(TKMovesetHeader);
+
+	return true;
+}
+
+// -- Private methods -- //
+
+void LocalStorage::LoadLibraryIndex()
+{
+	std::ifstream file(MOVESET_LIBRARY_INDEX, std::ios::binary);
+	if (file.fail()) {
+		return;
+	}
+
+	char signature[4];
+	uint32_t headerSize;
+	uint32_t entryCount;
+	file.read(signature, sizeof(signature));
+	file.read((char*)&headerSize, sizeof(headerSize));
+	file.read((char*)&entryCount, sizeof(entryCount));
+
+	// Any change to the header structure invalidates the whole index
+	if (file.fail() || strncmp(signature, "TKMI", 4) != 0 || headerSize != sizeof(TKMovesetHeader)) {
+		DEBUG_LOG("LoadLibraryIndex: invalid or outdated library index, ignoring it\n");
+		return;
+	}
+
+	for (uint32_t i = 0; i < entryCount; ++i)
 	{
-		TKMovesetHeader movesetInfos;
-		file.read((char*)&movesetInfos, sizeof(TKMovesetHeader));
+		uint32_t filenameLength;
+		file.read((char*)&filenameLength, sizeof(filenameLength));
+		if (file.fail() || filenameLength > MAX_PATH) {
+			break;
+		}
 
-		size_t readBytes = file.gcount();
-		file.seekg(0, std::ios::end);
-		size_t totalSize = file.tellg();
-		file.close();
+		std::wstring filename(filenameLength, L'\0');
+		movesetIndexEntry entry;
+		uint64_t modificationDate;
 
-		if (readBytes != sizeof(TKMovesetHeader) || !movesetInfos.ValidateHeader() ||
-			Helpers::isHeaderStringMalformated(movesetInfos.version_string, sizeof(movesetInfos.version_string)) ||
-			Helpers::isHeaderStringMalformated(movesetInfos.origin, sizeof(movesetInfos.origin)) ||
-			Helpers::isHeaderStringMalformated(movesetInfos.target_character, sizeof(movesetInfos.target_character))) {
-			// File malformated
-			return nullptr;
+		file.read((char*)filename.data(), filenameLength * sizeof(wchar_t));
+		file.read((char*)&modificationDate, sizeof(modificationDate));
+		file.read((char*)&entry.size, sizeof(entry.size));
+		file.read((char*)&entry.is_valid, sizeof(entry.is_valid));
+		if (entry.is_valid) {
+			file.read((char*)&entry.header, sizeof(entry.header));
 		}
-		else {
-			struct _stat buffer;
-			// _wstat() the file to read modification time
-			_wstat(filename.c_str(), &buffer);
-
-			// Build crc32 str string
-			std::string crc32Str;
-			{
-				char buffer[9];
-				sprintf_s(buffer, 9, "%08X", movesetInfos.crc32);
-				crc32Str = buffer;
+
+		if (file.fail()) {
+			break;
+		}
+
+		entry.modificationDate = (time_t)modificationDate;
+		m_libraryIndex.emplace(filename, entry);
+	}
+
+	DEBUG_LOG("LoadLibraryIndex: loaded %llu entries\n", m_libraryIndex.size());
+}
+
+void LocalStorage::SaveLibraryIndex()
+{
+	CreateDirectoryA(INTERFACE_DATA_DIR, nullptr);
+
+	// Write to a temporary file first so that a crash can't leave a truncated index behind
+	const std::string tmpFilename = MOVESET_LIBRARY_INDEX ".tmp";
+	{
+		std::ofstream file(tmpFilename, std::ios::binary);
+		if (file.fail()) {
+			return;
+		}
+
+		uint32_t headerSize = sizeof(TKMovesetHeader);
+		uint32_t entryCount = (uint32_t)m_libraryIndex.size();
+		file.write("TKMI", 4);
+		file.write((char*)&headerSize, sizeof(headerSize));
+		file.write((char*)&entryCount, sizeof(entryCount));
+
+		for (auto& [filename, entry] : m_libraryIndex)
+		{
+			uint32_t filenameLength = (uint32_t)filename.size();
+			uint64_t modificationDate = (uint64_t)entry.modificationDate;
+
+			file.write((char*)&filenameLength, sizeof(filenameLength));
+			file.write((char*)filename.data(), filenameLength * sizeof(wchar_t));
+			file.write((char*)&modificationDate, sizeof(modificationDate));
+			file.write((char*)&entry.size, sizeof(entry.size));
+			file.write((char*)&entry.is_valid, sizeof(entry.is_valid));
+			if (entry.is_valid) {
+				file.write((char*)&entry.header, sizeof(entry.header));
 			}
+		}
 
-			return new movesetInfo{
-				.color = getMovesetColor(movesetInfos.flags),
-				.filename = filename,
-				.name = Helpers::getMovesetNameFromFilename(filename),
-				.wname = Helpers::getMovesetWNameFromFilename(filename),
-				.origin = movesetInfos.origin,
-				.target_character = movesetInfos.target_character,
-				.original_character = movesetInfos.GetOrigCharacterName(),
-				.version_string = std::string(movesetInfos.version_string),
-				.date = movesetInfos.date,
-				.date_str = Helpers::formatDateTime(movesetInfos.date),
-				.extraction_date_str = Helpers::formatDateTime(movesetInfos.extraction_date),
-				.size = totalSize,
-				.sizeStr = std::format("{:.2f} {}", (float)totalSize / 1000 / 1000, _("moveset.size_mb")),
-				.hash = crc32Str,
-				.extractionDate = movesetInfos.extraction_date,
-				.modificationDate = buffer.st_mtime,
-				.gameId = movesetInfos.gameId,
-				.minorVersion = movesetInfos.minorVersion,
-				.modified = (movesetInfos.flags & MovesetFlags_MovesetModified) != 0,
-				.editable = Games::IsGameEditable(movesetInfos.gameId, movesetInfos.minorVersion),
-				.onlineImportable = totalSize < ONLINE_MOVESET_MAX_SIZE_BYTES,
-				.is_valid = true
-			};
-		}
-
-	}
-
-	return nullptr;
+		if (file.fail()) {
+			return;
+		}
+	}
+
+	try {
+		std::filesystem::rename(tmpFilename, MOVESET_LIBRARY_INDEX);
+		m_libraryIndexModified = false;
+	}
+	catch (std::exception&) {
+		DEBUG_ERR("SaveLibraryIndex: failed to save library index");
+	}
 }
 
-// -- Private methods -- //
+bool LocalStorage::FetchMovesetIndexEntry(const std::wstring& filename, movesetIndexEntry& entry_out, bool& fromIndex_out) const
+{
+	struct _stat buffer;
+	if (_wstat(filename.c_str(), &buffer) != 0) {
+		return false;
+	}
+
+	auto cachedEntry = m_libraryIndex.find(filename);
+	fromIndex_out = cachedEntry != m_libraryIndex.end() &&
+		cachedEntry->second.modificationDate == buffer.st_mtime && cachedEntry->second.size == (uint64_t)buffer.st_size;
+
+	if (fromIndex_out) {
+		memcpy(&entry_out, &cachedEntry->second, sizeof(movesetIndexEntry));
+		return true;
+	}
+
+	// New or modified file: read its header
+	return fetchMovesetHeader(filename, entry_out);
+}
+
+movesetInfo* LocalStorage::GetMovesetInformations(const std::wstring& filename, const movesetIndexEntry& entry, bool fromIndex)
+{
+	if (!fromIndex) {
+		m_libraryIndex.erase(filename);
+		m_libraryIndex.emplace(filename, entry);
+		m_libraryIndexModified = true;
+	}
+
+	if (!entry.is_valid) {
+		return nullptr;
+	}
+
+	movesetInfo* moveset = buildMovesetInformations(filename, entry.header, entry.size, entry.modificationDate);
+	if (moveset == nullptr) {
+		// Don't bother keeping the header of invalid files around
+		m_libraryIndex.find(filename)->second.is_valid = false;
+		m_libraryIndexModified = true;
+	}
+
+	return moveset;
+}
+
+movesetInfo* LocalStorage::GetMovesetInformations(const std::wstring& filename)
+{
+	movesetIndexEntry entry;
+	bool fromIndex;
+
+	if (!FetchMovesetIndexEntry(filename, entry, fromIndex)) {
+		return nullptr;
+	}
+	return GetMovesetInformations(filename, entry, fromIndex);
+}
+
+void LocalStorage::AddMovesetFiles(const std::vector<std::wstring>& filenames)
+{
+	struct fetchedEntry {
+		bool success;
+		bool fromIndex;
+		movesetIndexEntry entry;
+	};
+
+	// Reading headers is mostly spent waiting for the disk (or the network), so have many reads in flight at once
+	// The library index is only read from there, it is updated below once every read is done
+	std::vector<fetchedEntry> fetchedEntries(filenames.size());
+	Helpers::ParallelFor(filenames.size(), [&](size_t i) {
+		fetchedEntry& f = fetchedEntries[i];
+		f.success = FetchMovesetIndexEntry(filenames[i], f.entry, f.fromIndex);
+	}, MOVESET_LIBRARY_SCAN_THREADS);
+
+	// Merge in the listing order
+	for (size_t i = 0; i < filenames.size(); ++i)
+	{
+		const fetchedEntry& f = fetchedEntries[i];
+		movesetInfo* moveset = f.success ? GetMovesetInformations(filenames[i], f.entry, f.fromIndex) : nullptr;
+		AddMovesetFile(filenames[i], moveset);
+	}
+}
+
+void LocalStorage::AddMovesetFile(const std::wstring& filename, movesetInfo* moveset)
+{
+	m_extractedMovesetFilenames.insert(filename);
+
+	if (moveset == nullptr) {
+		moveset = new movesetInfo{
+			.color = MOVESET_INVALID,
+			.filename = filename,
+			.name = Helpers::getMovesetNameFromFilename(filename),
+			.origin = std::string("INVALID"),
+			.target_character = "",
+			.original_character = "",
+			.date = 0,
+			.size = 0,
+			.modificationDate = 0,
+			.modified = false,
+			.editable = false,
+			.is_valid = false
+		};
+	}
+
+	m_movesets.push_back(std::shared_ptr<movesetInfo>(moveset));
+	m_movesetListModified = true;
+}
+
+void LocalStorage::OnMovesetFileChanged(const std::wstring& filename)
+{
+	// Drop the entry we had about this file, if any
+	if (m_extractedMovesetFilenames.contains(filename))
+	{
+		for (size_t i = 0; i < m_movesets.size(); ++i)
+		{
+			if (m_movesets[i]->filename == filename) {
+				m_movesets.erase(m_movesets.begin() + i);
+				m_movesetListModified = true;
+				break;
+			}
+		}
+		m_extractedMovesetFilenames.erase(filename);
+	}
+
+	struct _stat buffer;
+	bool fileExists = _wstat(filename.c_str(), &buffer) == 0;
+
+	if (!fileExists) {
+		// Deleted or renamed away
+		if (m_libraryIndex.erase(filename) != 0) {
+			m_libraryIndexModified = true;
+		}
+		return;
+	}
+
+	if (buffer.st_size == 0 || std::filesystem::path(filename).extension().wstring() != L"" MOVESET_FILENAME_EXTENSION) {
+		// Skip files that we do not recognize or that are not yet fully written
+		return;
+	}
+
+	// Created, modified or renamed into place
+	AddMovesetFile(filename, GetMovesetInformations(filename));
+}
+
+void LocalStorage::PublishMovesetList()
+{
+	auto newList = std::make_shared<movesetList>();
+	auto& movesets = newList->movesets;
+
+	movesets = m_movesets;
+	std::sort(movesets.begin(), movesets.end(), [](const std::shared_ptr<movesetInfo>& a, const std::shared_ptr<movesetInfo>& b) {
+		return a->filename < b->filename;
+	});
+
+	// Build every sorted order, ties are kept in filename order
+	auto buildOrder = [&movesets](std::vector<size_t>& order, auto comp) {
+		order.resize(movesets.size());
+		for (size_t i = 0; i < order.size(); ++i) {
+			order[i] = i;
+		}
+		std::stable_sort(order.begin(), order.end(), [&movesets, &comp](size_t a, size_t b) {
+			return comp(*movesets[a], *movesets[b]);
+		});
+	};
+
+	buildOrder(newList->sorted[movesetListSort_Name], [](const movesetInfo& a, const movesetInfo& b) { return a.name < b.name; });
+	buildOrder(newList->sorted[movesetListSort_Origin], [](const movesetInfo& a, const movesetInfo& b) { return a.origin.str() < b.origin.str(); });
+	buildOrder(newList->sorted[movesetListSort_TargetCharacter], [](const movesetInfo& a, const movesetInfo& b) { return a.target_character < b.target_character; });
+	buildOrder(newList->sorted[movesetListSort_Date], [](const movesetInfo& a, const movesetInfo& b) { return a.date < b.date; });
+	buildOrder(newList->sorted[movesetListSort_Size], [](const movesetInfo& a, const movesetInfo& b) { return a.size < b.size; });
+
+	m_publishedMovesets.store(std::move(newList));
+	m_movesetListModified = false;
+}
+
+bool LocalStorage::WatchMovesetDirectory()
+{
+	HANDLE hDirectory = CreateFileW(L"" MOVESET_DIRECTORY, FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+		nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+
+	if (hDirectory == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	OVERLAPPED overlapped{};
+	overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+	if (overlapped.hEvent == nullptr) {
+		CloseHandle(hDirectory);
+		return false;
+	}
+
+	// DWORD-aligned, as required by ReadDirectoryChangesW
+	DWORD changesBuffer[MOVESET_DIRECTORY_WATCH_BUFSIZE / sizeof(DWORD)];
+	const DWORD notifyFilter = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE;
+	bool watching = ReadDirectoryChangesW(hDirectory, changesBuffer, sizeof(changesBuffer), FALSE, notifyFilter, nullptr, &overlapped, nullptr);
+	bool waitFailed = false;
+
+	while (watching && m_threadStarted && !m_refreshMovesets)
+	{
+		// Thread stops & refresh requests set the wake event. Without it, wake up regularly in order to notice them.
+		HANDLE events[2] = { overlapped.hEvent, m_wakeEvent };
+		DWORD waitResult = m_wakeEvent != nullptr ? WaitForMultipleObjects(2, events, FALSE, INFINITE) : WaitForSingleObject(overlapped.hEvent, GAME_INTERACTION_THREAD_SLEEP_MS);
+		if (waitResult == WAIT_FAILED) {
+			// Would fail again immediately: stop watching and let the caller fall back to polling
+			DEBUG_ERR("Moveset directory watch: wait failed (error %u)", GetLastError());
+			waitFailed = true;
+			break;
+		}
+		if (waitResult != WAIT_OBJECT_0) {
+			if (m_wakeEvent != nullptr) {
+				ResetEvent(m_wakeEvent);
+			}
+			continue;
+		}
+
+		DWORD bytesReturned = 0;
+		if (!GetOverlappedResult(hDirectory, &overlapped, &bytesReturned, FALSE) || bytesReturned == 0) {
+			// Directory deleted or too many changes to fit in our buffer: rescan the whole directory
+			watching = false;
+			break;
+		}
+
+		// Gather the changed files first, a single write usually triggers several notifications
+		std::set<std::wstring> changedFiles;
+		const Byte* cursor = (Byte*)changesBuffer;
+		while (true)
+		{
+			const FILE_NOTIFY_INFORMATION* info = (FILE_NOTIFY_INFORMATION*)cursor;
+			std::wstring name(info->FileName, info->FileNameLength / sizeof(WCHAR));
+			changedFiles.insert((std::filesystem::path(L"" MOVESET_DIRECTORY) / name).wstring());
+
+			if (info->NextEntryOffset == 0) {
+				break;
+			}
+			cursor += info->NextEntryOffset;
+		}
+
+		// Queue the next read before processing so that no change gets lost in between
+		ResetEvent(overlapped.hEvent);
+		watching = ReadDirectoryChangesW(hDirectory, changesBuffer, sizeof(changesBuffer), FALSE, notifyFilter, nullptr, &overlapped, nullptr);
+
+		for (const std::wstring& filename : changedFiles) {
+			OnMovesetFileChanged(filename);
+		}
+
+		if (m_movesetListModified) {
+			PublishMovesetList();
+		}
+
+		if (m_libraryIndexModified) {
+			SaveLibraryIndex();
+		}
+	}
+
+	if (watching) {
+		// Read still pending, wait for its cancellation before freeing the buffer it writes into
+		DWORD bytesReturned;
+		CancelIoEx(hDirectory, &overlapped);
+		GetOverlappedResult(hDirectory, &overlapped, &bytesReturned, TRUE);
+	}
+
+	CloseHandle(overlapped.hEvent);
+	CloseHandle(hDirectory);
+	return !waitFailed;
+}
 
 void LocalStorage::Update()
 {
@@ -97,56 +462,78 @@ void LocalStorage::Update()
 		// Update the list of moveset files. This is better than doing it in the display thread
 		ReloadMovesetList();
 
-		std::this_thread::sleep_for(std::chrono::milliseconds(GAME_INTERACTION_THREAD_SLEEP_MS));
+		// Then only apply the changes reported by the system until a refresh is requested or the watch is lost
+		if (!WatchMovesetDirectory()) {
+			// Directory can't be watched (likely doesn't exist yet) or the wait failed: fallback to polling
+			SleepFor(std::chrono::milliseconds(GAME_INTERACTION_THREAD_SLEEP_MS));
+		}
 	}
 }
 
 // -- Public methods -- //
 
+void LocalStorage::StartThread()
+{
+	if (!m_threadStarted && m_wakeEvent == nullptr) {
+		m_wakeEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+	}
+	ThreadedClass::StartThread();
+}
+
+void LocalStorage::WakeThread()
+{
+	ThreadedClass::WakeThread();
+	if (m_wakeEvent != nullptr) {
+		SetEvent(m_wakeEvent);
+	}
+}
+
 void LocalStorage::StopThreadAndCleanup()
 {
 	// Order thread to stop
 	if (m_threadStarted)
 	{
 		m_threadStarted = false;
+		WakeThread();
 		m_t.join();
 	}
 
-	// Free allocated ressources
-	CleanupUnusedMovesetInfos();
-	for (movesetInfo* movesetInfo : extractedMovesets) {
-		delete movesetInfo;
+	if (m_wakeEvent != nullptr) {
+		CloseHandle(m_wakeEvent);
+		m_wakeEvent = nullptr;
 	}
+
 }
 
 void LocalStorage::ReloadMovesetList()
 {
+	if (!m_libraryIndexLoaded) {
+		LoadLibraryIndex();
+		m_libraryIndexLoaded = true;
+	}
+
 	if (m_refreshMovesets)
 	{
-		for (unsigned int i = 0; i < extractedMovesets.size();)
-		{
-			auto m = extractedMovesets[i];
-			m_garbage.push_back(m);
-			m_extractedMovesetFilenames.erase(m_extractedMovesetFilenames.find(m->filename));
-			extractedMovesets.erase(extractedMovesets.begin());
-		}
+		m_movesets.clear();
+		m_extractedMovesetFilenames.clear();
+		m_movesetListModified = true;
 		m_refreshMovesets = false;
 	}
 
 	// Delete moveset entries that don't exist anymore (deleted files)
-	for (size_t i = 0; i < extractedMovesets.size();) {
-		movesetInfo* moveset = extractedMovesets[i];
+	for (size_t i = 0; i < m_movesets.size();) {
+		movesetInfo* moveset = m_movesets[i].get();
 		struct _stat buffer;
 
 		bool statFailed = _wstat(moveset->filename.c_str(), &buffer) != 0;
 
 		if (statFailed ||
 			(moveset->modificationDate != 0 && (buffer.st_mtime != moveset->modificationDate || buffer.st_size != moveset->size))) {
-			// File does not exist anymore or was recently modified, de-allocate the info we stored about it
-			// (We remove from the set FIRST because erasing from the vector calls the std::string destuctor)
+			// File does not exist anymore or was recently modified, forget the info we stored about it
+			// (We remove from the set FIRST because erasing from the vector may call the std::string destuctor)
 			m_extractedMovesetFilenames.erase(m_extractedMovesetFilenames.find(moveset->filename));
-			extractedMovesets.erase(extractedMovesets.begin() + i);
-			m_garbage.push_back(moveset);
+			m_movesets.erase(m_movesets.begin() + i);
+			m_movesetListModified = true;
 		}
 		else {
 			++i;
@@ -155,6 +542,8 @@ void LocalStorage::ReloadMovesetList()
 
 	if (Helpers::fileExists(L"" MOVESET_DIRECTORY))
 	{
+		std::vector<std::wstring> newFiles;
+
 		for (const auto& entry : std::filesystem::directory_iterator(L"" MOVESET_DIRECTORY))
 		{
 			std::filesystem::path file = entry.path();
@@ -167,42 +556,38 @@ void LocalStorage::ReloadMovesetList()
 			}
 
 			// If new file is detected, fetch its infos
-			if (!m_extractedMovesetFilenames.contains(filename))
-			{
-				m_extractedMovesetFilenames.insert(filename);
-				movesetInfo* moveset = fetchMovesetInformations(filename);
-
-				if (moveset == nullptr) {
-					moveset = new movesetInfo{
-						.color = MOVESET_INVALID,
-						.filename = filename,
-						.name = Helpers::getMovesetNameFromFilename(filename),
-						.origin = std::string("INVALID"),
-						.target_character = "",
-						.original_character = "",
-						.date = 0,
-						.size = 0,
-						.modificationDate = 0,
-						.modified = false,
-						.editable = false,
-						.is_valid = false
-					};
-				}
-
-				extractedMovesets.push_back(moveset);
+			if (!m_extractedMovesetFilenames.contains(filename)) {
+				newFiles.push_back(filename);
 			}
 		}
+
+		AddMovesetFiles(newFiles);
 	}
-}
 
-void LocalStorage::CleanupUnusedMovesetInfos()
-{
-	while (m_garbage.size() > 0)
+	// Forget about the files that don't exist anymore
+	for (auto it = m_libraryIndex.begin(); it != m_libraryIndex.end();)
 	{
-		movesetInfo* moveset = m_garbage[0];
-		m_garbage.erase(m_garbage.begin());
-		delete moveset;
+		if (!m_extractedMovesetFilenames.contains(it->first)) {
+			it = m_libraryIndex.erase(it);
+			m_libraryIndexModified = true;
+		}
+		else {
+			++it;
+		}
 	}
+
+	if (m_movesetListModified) {
+		PublishMovesetList();
+	}
+
+	if (m_libraryIndexModified) {
+		SaveLibraryIndex();
+	}
+}
+
+std::shared_ptr<const movesetList> LocalStorage::GetMovesetList() const
+{
+	return m_publishedMovesets.load();
 }
 
 bool LocalStorage::DeleteMoveset(const wchar_t* filename)
@@ -217,11 +602,6 @@ bool LocalStorage::DeleteMoveset(const wchar_t* filename)
 	return true;
 }
 
-LocalStorage::~LocalStorage()
-{
-	CleanupUnusedMovesetInfos();
-}
-
 void LocalStorage::RefreshMovesets()
 {
 	if (m_refreshMovesets) return;
@@ -229,6 +609,7 @@ void LocalStorage::RefreshMovesets()
 
 	// Set m_refreshMovesets to true so that ReloadMovesetList() will completely clear the moveset list on its next call
 	m_refreshMovesets = true;
+	WakeThread();
 	while (!m_refreshMovesets)
 	{
 		std::this_thread::sleep_for(std::chrono::milliseconds(100));
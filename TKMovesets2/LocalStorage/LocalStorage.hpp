@@ -1,11 +1,16 @@
 #pragma once
 
 #include <set>
+#include <map>
 #include <vector>
+#include <memory>
+#include <atomic>
 
 #include "ThreadedClass.hpp"
 #include "Helpers.hpp"
 
+#include "MovesetStructs.h"
+
 // Moveset info, most of which is read straight from the file. Use for display.
 struct movesetInfo
 {
@@ -39,32 +44,102 @@ struct movesetInfo
 	bool is_valid;
 };
 
+// Cached informations about a moveset file, stored in the library index
+struct movesetIndexEntry
+{
+	time_t modificationDate;
+	uint64_t size;
+	// False if the file was found to be invalid, in which case the header is not stored
+	bool is_valid;
+	TKMovesetHeader header;
+};
+
+// Orders in which a moveset list can be browsed
+enum movesetListSort_
+{
+	movesetListSort_Name,
+	movesetListSort_Origin,
+	movesetListSort_TargetCharacter,
+	movesetListSort_Date,
+	movesetListSort_Size,
+
+	movesetListSort_Count,
+};
+
+// List of moveset infos. Published lists are never modified, and an info stays alive as long as a list referencing it does.
+struct movesetList
+{
+	// Movesets, sorted by filename
+	std::vector<std::shared_ptr<movesetInfo>> movesets;
+	// Positions in .movesets, in ascending order of every movesetListSort_ criteria. Built along with the list so that the display thread never has to sort it.
+	std::vector<size_t> sorted[movesetListSort_Count];
+
+	// Returns the moveset at the given position of the list when sorted by [sort]
+	const std::shared_ptr<movesetInfo>& GetSorted(movesetListSort_ sort, bool descending, size_t position) const
+	{
+		const std::vector<size_t>& order = sorted[sort];
+		return movesets[order[descending ? order.size() - 1 - position : position]];
+	}
+};
+
 class LocalStorage : public ThreadedClass
 {
 private:
-	// Contains the list of movesets found in the extraction directory
-	std::vector<movesetInfo*> localMovesets;
+	// Working copy of the moveset list, only ever accessed by the thread building it
+	std::vector<std::shared_ptr<movesetInfo>> m_movesets;
+	// Last published snapshot of the moveset list, read by the display thread without locking
+	std::atomic<std::shared_ptr<const movesetList>> m_publishedMovesets = std::make_shared<const movesetList>();
+	// If true, .m_movesets changed since it was last published
+	bool m_movesetListModified = false;
 	// A set containing the list of moveset files in the configured extraction dir. Used to determine when to fetch new movesets info
 	std::set<std::wstring> m_extractedMovesetFilenames;
-	// .extractedMovesets garbage, because it can be accessed in another thread while we remove items for it.
-	std::vector<movesetInfo*> m_garbage;
 	// If true, will clear the moveset list and refresh it in the next run
 	bool m_refreshMovesets = false;
+	// Headers of every moveset file previously read, keyed by filename. Saved on disk so that only new or modified files have to be read on startup.
+	std::map<std::wstring, movesetIndexEntry> m_libraryIndex;
+	// If true, the library index was modified and has to be saved
+	bool m_libraryIndexModified = false;
+	// If true, the library index was read from the disk
+	bool m_libraryIndexLoaded = false;
+	// Win32 event set by WakeThread(), interrupts the wait for directory changes
+	void* m_wakeEvent = nullptr;
+
+	// Loads the library index from the disk
+	void LoadLibraryIndex();
+	// Saves the library index to the disk
+	void SaveLibraryIndex();
+	// Reads the header of a moveset file from the library index if the file wasn't modified, or from the file otherwise
+	// Does not modify the library index, so it can be called from multiple threads at once
+	bool FetchMovesetIndexEntry(const std::wstring& filename, movesetIndexEntry& entry_out, bool& fromIndex_out) const;
+	// Builds the infos of a moveset file from its header, storing the header in the library index if it was read from the file
+	movesetInfo* GetMovesetInformations(const std::wstring& filename, const movesetIndexEntry& entry, bool fromIndex);
+	// Builds the infos of a moveset file, reading its header from the library index if it wasn't modified, or from the file otherwise
+	movesetInfo* GetMovesetInformations(const std::wstring& filename);
+	// Adds a moveset file to the list, valid or not. [moveset] can be null for invalid files.
+	void AddMovesetFile(const std::wstring& filename, movesetInfo* moveset);
+	// Reads the headers of multiple new files in parallel and adds them to the list in the given order
+	void AddMovesetFiles(const std::vector<std::wstring>& filenames);
+	// Removes, re-reads or adds the entry of a single file that was reported as created, modified, renamed or deleted
+	void OnMovesetFileChanged(const std::wstring& filename);
+	// Waits for changes in the moveset directory and applies them incrementally. Returns false if the directory could not be watched or waiting on it failed.
+	// Returns once the thread is stopped, a refresh is requested, or the changes could not all be tracked (full rescan needed)
+	bool WatchMovesetDirectory();
+	// Sorts a copy of the working moveset list, builds its sorted orders and makes it the one returned by GetMovesetList()
+	void PublishMovesetList();
 
-	// Function ran in the parallel thread, used to list files regularly
+	// Function ran in the parallel thread, used to list files when they change
 	void Update() override;
 public:
-	// Contains the list of movesets found in the extraction directory
-	std::vector<movesetInfo*> extractedMovesets;
-
-	~LocalStorage();
-
+	// Starts the thread listing the movesets
+	void StartThread() override;
 	// Stops the thread started above
 	void StopThreadAndCleanup() override;
-	// Reads movesets from their configured extraction dir. Accessible under .extractedMovesets
+	// Interrupts the current wait for directory changes
+	void WakeThread() override;
+	// Reads movesets from their configured extraction dir. Accessible through GetMovesetList()
 	void ReloadMovesetList();
-	// Frees the content of .garbage. Must be called by the display thread after being finished with .extractedMovesets
-	void CleanupUnusedMovesetInfos();
+	// Returns the latest list of movesets found in the extraction directory. The list never changes, keep the pointer for as long as it is iterated on.
+	std::shared_ptr<const movesetList> GetMovesetList() const;
 	// Delete a moveset's file entirely, returns false if deletion failed
 	bool DeleteMoveset(const wchar_t* filename);
 	// Force movesets to refresj
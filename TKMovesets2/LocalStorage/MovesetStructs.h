@@ -11,6 +11,12 @@ enum TKMovesetCompressionType_
 
 	TKMovesetCompressionType_LZ4,
 	TKMovesetCompressionType_LZMA,
+	TKMovesetCompressionType_ZSTD,
+
+	// Set on top of the algorithm when the data is made of independent frames (see TKMovesetFrameIndex)
+	// Builds that predate frames see an unknown compression type and refuse the moveset instead of misreading it
+	TKMovesetCompressionType_Framed = 0x80,
+	TKMovesetCompressionType_AlgorithmMask = 0x7F,
 };
 
 enum TKMovesetProperty_
@@ -34,6 +40,32 @@ enum MovesetFlags_
 	MovesetFlags_Debug           = (1 << 1),
 };
 
+// One independently compressed part of the moveset data
+struct TKMovesetFrame
+{
+	// Offset of the compressed frame, relative to moveset_data_start
+	uint64_t compressed_offset;
+	// Size of the compressed frame
+	uint64_t compressed_size;
+	// Offset of the decompressed data, relative to the start of the decompressed moveset data
+	uint64_t offset;
+	// Size of the decompressed data
+	uint64_t size;
+};
+
+// Index of the frames of a moveset compressed in multiple frames. Stored right after the block list, before moveset_data_start.
+// Only present when the compression type has TKMovesetCompressionType_Framed, movesets compressed as a single stream do not have one.
+struct TKMovesetFrameIndex
+{
+	// Should always be TKMF
+	const char _signature[4] = { 'T', 'K', 'M', 'F' };
+	// Amount of TKMovesetFrame following this structure
+	uint32_t frame_count = 0;
+
+	const TKMovesetFrame* GetFrames() const { return (const TKMovesetFrame*)(this + 1); }
+	TKMovesetFrame* GetFrames() { return (TKMovesetFrame*)(this + 1); }
+};
+
 // This structure should really not change or it would break compatibility with all previous movesets
 // If you have any change in mind that might be important, do it now
 // Useful infos regarding the moveset : extracting date, game origin, game id, extractor version
@@ -101,6 +133,34 @@ struct TKMovesetHeader
 
 	bool isCompressed() const { return compressionType != TKMovesetCompressionType_None; }
 
+	// Returns true if the moveset data is compressed in multiple frames, described by the frame index
+	bool isFramed() const { return (compressionType & TKMovesetCompressionType_Framed) != 0; }
+
+	// Returns the compression algorithm, without the framing flag
+	TKMovesetCompressionType_ GetCompressionAlgorithm() const { return (TKMovesetCompressionType_)(compressionType & TKMovesetCompressionType_AlgorithmMask); }
+
+	// Returns the offset at which the block list ends, which is where the frame index is stored if there is one
+	uint32_t GetBlockListEnd() const
+	{
+		return block_list + (uint32_t)Helpers::align8Bytes(block_list_size * sizeof(uint64_t));
+	}
+
+	// Returns the frame index of movesets compressed in multiple frames, nullptr if the moveset was compressed as a single stream
+	// Header has to be followed by the rest of the moveset in memory (at least up to moveset_data_start)
+	const TKMovesetFrameIndex* GetFrameIndex() const
+	{
+		if (!isFramed()) return nullptr;
+
+		uint32_t indexOffset = GetBlockListEnd();
+		if (moveset_data_start < indexOffset + sizeof(TKMovesetFrameIndex)) return nullptr;
+
+		const TKMovesetFrameIndex* index = (const TKMovesetFrameIndex*)((const Byte*)this + indexOffset);
+		if (strncmp(index->_signature, "TKMF", 4) != 0) return nullptr;
+		if (moveset_data_start < indexOffset + sizeof(TKMovesetFrameIndex) + (uint64_t)index->frame_count * sizeof(TKMovesetFrame)) return nullptr;
+
+		return index;
+	}
+
 	// -- Version specific -- //
 
 	uint64_t GetConversionOrigin() const
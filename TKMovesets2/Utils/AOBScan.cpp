@@ -0,0 +1,275 @@
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <immintrin.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+// MSVC lets AVX2 intrinsics be used anywhere, it is up to us to only call them on supported CPUs
+# define AOB_TARGET_AVX2
+#else
+# define AOB_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+#include "AOBScan.hpp"
+#include "Helpers.hpp"
+
+#include "constants.h"
+
+// -- Static helpers -- //
+
+static int HexCharToNibble(char c)
+{
+	if ('0' <= c && c <= '9') return c - '0';
+	if ('a' <= c && c <= 'f') return c - 'a' + 10;
+	if ('A' <= c && c <= 'F') return c - 'A' + 10;
+	return -1;
+}
+
+static unsigned int CountTrailingZeros(uint32_t value)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward(&index, value);
+	return index;
+#else
+	return __builtin_ctz(value);
+#endif
+}
+
+static bool CpuSupportsAVX2()
+{
+#ifdef _MSC_VER
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7) {
+		return false;
+	}
+
+	// The OS also has to save the YMM registers on context switches
+	__cpuid(info, 1);
+	if ((info[2] & (1 << 27)) == 0 || (_xgetbv(0) & 6) != 6) {
+		return false;
+	}
+
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#else
+	return __builtin_cpu_supports("avx2");
+#endif
+}
+
+// Candidate positions are those where the two anchor bytes of the pattern are found, they are then compared entirely
+// Returns the offset of the first match in [data] or AOB_NOT_FOUND. Positions the SIMD loop can't reach are left to the caller.
+static uint64_t FindPatternSSE2(const Byte* data, size_t size, const AOBPattern& pattern, size_t& scanned_out)
+{
+	const size_t patternSize = pattern.bytes.size();
+	const __m128i first = _mm_set1_epi8((char)pattern.bytes[pattern.anchor]);
+	const __m128i second = _mm_set1_epi8((char)pattern.bytes[pattern.anchor + 1]);
+
+	size_t pos = 0;
+	// Loads go from [pos + anchor] to [pos + anchor + 16], and the whole pattern has to fit from the last candidate
+	while (pos + pattern.anchor + 1 + 16 <= size && pos + 16 + patternSize - 1 <= size)
+	{
+		__m128i a = _mm_loadu_si128((const __m128i*)(data + pos + pattern.anchor));
+		__m128i b = _mm_loadu_si128((const __m128i*)(data + pos + pattern.anchor + 1));
+		uint32_t candidates = (uint32_t)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, second)));
+
+		while (candidates != 0)
+		{
+			size_t candidate = pos + CountTrailingZeros(candidates);
+			if (AOBScanUtils::MatchesAt(data + candidate, pattern)) {
+				return candidate;
+			}
+			candidates &= candidates - 1;
+		}
+		pos += 16;
+	}
+
+	scanned_out = pos;
+	return AOB_NOT_FOUND;
+}
+
+AOB_TARGET_AVX2
+static uint64_t FindPatternAVX2(const Byte* data, size_t size, const AOBPattern& pattern, size_t& scanned_out)
+{
+	const size_t patternSize = pattern.bytes.size();
+	const __m256i first = _mm256_set1_epi8((char)pattern.bytes[pattern.anchor]);
+	const __m256i second = _mm256_set1_epi8((char)pattern.bytes[pattern.anchor + 1]);
+
+	size_t pos = 0;
+	while (pos + pattern.anchor + 1 + 32 <= size && pos + 32 + patternSize - 1 <= size)
+	{
+		__m256i a = _mm256_loadu_si256((const __m256i*)(data + pos + pattern.anchor));
+		__m256i b = _mm256_loadu_si256((const __m256i*)(data + pos + pattern.anchor + 1));
+		uint32_t candidates = (uint32_t)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, first), _mm256_cmpeq_epi8(b, second)));
+
+		while (candidates != 0)
+		{
+			size_t candidate = pos + CountTrailingZeros(candidates);
+			if (AOBScanUtils::MatchesAt(data + candidate, pattern)) {
+				return candidate;
+			}
+			candidates &= candidates - 1;
+		}
+		pos += 32;
+	}
+
+	scanned_out = pos;
+	return AOB_NOT_FOUND;
+}
+
+namespace AOBScanUtils
+{
+	bool ParsePattern(const char* bytesString, AOBPattern& out)
+	{
+		const char* patternStart = bytesString;
+		out.bytes.clear();
+		out.mask.clear();
+
+		while (*bytesString != '\0')
+		{
+			// Ignore spaces
+			while (*bytesString != '\0' && (*bytesString == ' ' || !isprint((unsigned char)*bytesString))) ++bytesString;
+			if (*bytesString == '\0') break;
+
+			char firstChar = bytesString[0];
+			char secondChar = bytesString[1];
+			if (secondChar == '\0') {
+				DEBUG_ERR("AOB pattern '%s' ends with a lone nibble", patternStart);
+				return false;
+			}
+
+			Byte value = 0;
+			Byte mask = 0;
+			if (firstChar != '?') {
+				int nibble = HexCharToNibble(firstChar);
+				if (nibble == -1) return false;
+				value |= nibble << 4;
+				mask |= 0xF0;
+			}
+			if (secondChar != '?') {
+				int nibble = HexCharToNibble(secondChar);
+				if (nibble == -1) return false;
+				value |= nibble;
+				mask |= 0x0F;
+			}
+
+			out.bytes.push_back(value);
+			out.mask.push_back(mask);
+
+			bytesString += 2;
+		}
+
+		// Look for two known bytes in a row to search for: one byte alone gives way too many candidates
+		for (out.anchor = 0; out.anchor + 1 < out.bytes.size(); ++out.anchor)
+		{
+			if (out.mask[out.anchor] == 0xFF && out.mask[out.anchor + 1] == 0xFF) {
+				break;
+			}
+		}
+		if (out.anchor + 1 >= out.bytes.size()) {
+			return false;
+		}
+
+		out.hash = Helpers::crc32_update(0, out.bytes.data(), out.bytes.size());
+		out.hash = Helpers::crc32_update(out.hash, out.mask.data(), out.mask.size());
+		return true;
+	}
+
+	bool MatchesAt(const Byte* data, const AOBPattern& pattern)
+	{
+		for (size_t i = 0; i < pattern.bytes.size(); ++i)
+		{
+			if ((data[i] & pattern.mask[i]) != pattern.bytes[i]) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void FindPatterns(const Byte* data, size_t size, const std::vector<AOBPattern>& patterns, std::vector<uint64_t>& offsets_out)
+	{
+		static const bool useAVX2 = CpuSupportsAVX2();
+
+		for (size_t i = 0; i < patterns.size(); ++i)
+		{
+			if (offsets_out[i] != AOB_NOT_FOUND) {
+				continue;
+			}
+
+			const AOBPattern& pattern = patterns[i];
+			if (pattern.bytes.size() > size) {
+				continue;
+			}
+
+			// The window is small enough to stay in the CPU cache while every pattern goes over it
+			size_t scanned = 0;
+			uint64_t offset = useAVX2 ? FindPatternAVX2(data, size, pattern, scanned) : FindPatternSSE2(data, size, pattern, scanned);
+
+			// Positions too close to the end for the SIMD loads
+			for (size_t pos = scanned; offset == AOB_NOT_FOUND && pos + pattern.bytes.size() <= size; ++pos)
+			{
+				if (MatchesAt(data + pos, pattern)) {
+					offset = pos;
+				}
+			}
+
+			offsets_out[i] = offset;
+		}
+	}
+
+	std::map<uint32_t, uint64_t> LoadCachedResults(uint32_t exeHash)
+	{
+		std::map<uint32_t, uint64_t> results;
+		std::ifstream file(AOB_SCAN_CACHE_FILE);
+		std::string line;
+
+		while (std::getline(file, line))
+		{
+			std::istringstream stream(line);
+			uint32_t lineExeHash, patternHash;
+			uint64_t offset;
+
+			if (stream >> std::hex >> lineExeHash >> patternHash >> offset && lineExeHash == exeHash) {
+				results[patternHash] = offset;
+			}
+		}
+
+		return results;
+	}
+
+	void SaveCachedResults(uint32_t exeHash, const std::map<uint32_t, uint64_t>& results)
+	{
+		// Keep the results of other executables, other versions of the game might still be in use
+		std::vector<std::string> lines;
+		{
+			std::ifstream file(AOB_SCAN_CACHE_FILE);
+			std::string line;
+			while (std::getline(file, line))
+			{
+				std::istringstream stream(line);
+				uint32_t lineExeHash;
+				if (stream >> std::hex >> lineExeHash && lineExeHash != exeHash) {
+					lines.push_back(line);
+				}
+			}
+		}
+
+		std::error_code ec;
+		std::filesystem::create_directories(INTERFACE_DATA_DIR, ec);
+
+		std::ofstream file(AOB_SCAN_CACHE_FILE);
+		if (file.fail()) {
+			DEBUG_ERR("Failed to open '%s' for writing", AOB_SCAN_CACHE_FILE);
+			return;
+		}
+
+		for (const std::string& line : lines) {
+			file << line << '\n';
+		}
+		for (auto& [patternHash, offset] : results) {
+			file << std::hex << exeHash << ' ' << patternHash << ' ' << offset << '\n';
+		}
+	}
+};
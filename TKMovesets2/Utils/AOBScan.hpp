@@ -0,0 +1,40 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "GameTypes.h"
+
+// Returned by FindPatterns() for patterns that were not found
+# define AOB_NOT_FOUND ((uint64_t)-1)
+
+// Parsed memory string such as '00 F7 E1 45 0? 45 ?? ?? 89'
+struct AOBPattern
+{
+	// Bytes to match, wildcard nibbles are set to 0
+	std::vector<Byte> bytes;
+	// 0xFF for fully known bytes, 0xF0 / 0x0F for half-wildcards, 0 for '??'
+	std::vector<Byte> mask;
+	// Position of the first two consecutive fully known bytes, searched for before comparing the whole pattern
+	size_t anchor;
+	// Hash of the pattern, identifies it in the scan cache
+	uint32_t hash;
+};
+
+namespace AOBScanUtils
+{
+	// Parses a memory string. Returns false if the string is empty, malformed (such as ending with a lone nibble) or has no two consecutive non-wildcard bytes.
+	bool ParsePattern(const char* bytesString, AOBPattern& out);
+	// Returns true if [data] starts with the pattern. [data] must be at least as big as the pattern.
+	bool MatchesAt(const Byte* data, const AOBPattern& pattern);
+	// Finds the first occurence of every pattern within [data], writing its offset in [offsets_out]
+	// Only patterns whose offset is AOB_NOT_FOUND are looked for, which allows scanning a big area window by window
+	// Uses AVX2 if the CPU supports it, SSE2 otherwise
+	void FindPatterns(const Byte* data, size_t size, const std::vector<AOBPattern>& patterns, std::vector<uint64_t>& offsets_out);
+
+	// Returns the offsets found in a previous scan of an executable, keyed by pattern hash
+	std::map<uint32_t, uint64_t> LoadCachedResults(uint32_t exeHash);
+	// Saves the offsets found in an executable, replacing the ones previously saved for it
+	void SaveCachedResults(uint32_t exeHash, const std::map<uint32_t, uint64_t>& results);
+};
@@ -466,6 +466,40 @@ namespace TAnimUtils
 		};
 	};
 
+	// Local copy of an area of a process' memory, from which the animation fields are read
+	// Fields are close to each other: most of them end up being served by the same chunk instead of costing one read each
+	struct s_processChunk
+	{
+		const GameProcess& process;
+		gameAddr start = 0;
+		uint64_t size = 0;
+		Byte data[GAME_READ_CACHE_PAGE_SIZE];
+
+		// Returns a pointer to [readSize] bytes at [addr], reading a new chunk from the process if they aren't in the current one
+		const Byte* Get(gameAddr addr, uint64_t readSize)
+		{
+			if (addr < start || addr + readSize > start + size)
+			{
+				// Read up to the end of the page: the next one might not be mapped, which would make the whole read fail
+				start = addr;
+				size = GAME_READ_CACHE_PAGE_SIZE - (addr % GAME_READ_CACHE_PAGE_SIZE);
+				if (size < readSize) {
+					size = readSize;
+				}
+
+				GameProcessReadRequest request = { .addr = start, .buf = data, .size = size };
+				if (!process.readBatch(&request, 1))
+				{
+					// Fall back to reading only what was asked for
+					size = readSize;
+					memset(data, 0, readSize);
+					process.readBytes(addr, data, readSize);
+				}
+			}
+			return data + (addr - start);
+		}
+	};
+
 	namespace FromProcess
 	{
 		bool IsLittleEndian(const GameProcess& process, gameAddr anim)
@@ -476,18 +510,9 @@ namespace TAnimUtils
 
 		uint64_t getC8AnimSize(const GameProcess& process, gameAddr anim)
 		{
-			bool isSwapped = !IsLittleEndian(process, anim);
-
-			uint8_t bone_count = process.readInt8(anim + (isSwapped ? 3 : 2));
-			uint32_t header_size = bone_count * 0x4 + 0x8;
-			uint32_t frame_size = bone_count * 0x4 * 3;
-
-			uint32_t length = process.readInt32(anim + 4);
-			if (isSwapped) {
-				length = BYTESWAP_INT32(length);
-			}
-
-			return (int64_t)header_size + (int64_t)frame_size * (int64_t)length;
+			// Everything needed is within the first 8 bytes
+			s_processChunk chunk{ process };
+			return FromMemory::getC8AnimSize(chunk.Get(anim, 8));
 		}
 
 		uint64_t get64AnimSize(const GameProcess& process, gameAddr anim)
@@ -499,15 +524,16 @@ namespace TAnimUtils
 		uint64_t get64AnimSize_BigEndian(const GameProcess& process, gameAddr anim)
 		{
 			// Do all calculations in uint64_t that way i don't have to pay attention to possible overflows
+			s_processChunk chunk{ process };
 
-			uint64_t boneCount = process.readInt16(anim + 2);
+			uint64_t boneCount = READ(chunk.Get(anim + 2, 2), int16_t);
 			boneCount = BYTESWAP_INT16(boneCount);
 
 			uint64_t postBoneDescriptor_offset = (4 + boneCount * sizeof(uint16_t));
 			gameAddr anim_postBoneDescriptorAddr = (gameAddr)(anim + postBoneDescriptor_offset);
 
-			uint64_t animLength = (uint16_t)process.readInt16(anim_postBoneDescriptorAddr);
-			uint64_t __unknown__ = (uint16_t)process.readInt16(anim_postBoneDescriptorAddr + 4);
+			uint64_t animLength = (uint16_t)READ(chunk.Get(anim_postBoneDescriptorAddr, 2), int16_t);
+			uint64_t __unknown__ = (uint16_t)READ(chunk.Get(anim_postBoneDescriptorAddr + 4, 2), int16_t);
 			animLength = BYTESWAP_INT16(animLength);
 			__unknown__ = BYTESWAP_INT16(__unknown__);
 
@@ -518,7 +544,7 @@ namespace TAnimUtils
 
 			unsigned int baseFrame = (unsigned int)animLength - (animLength >= 2 ? 2 : 1);
 			unsigned int keyframe = baseFrame / 16;
-			unsigned int _v56_intPtr = (unsigned int)process.readInt32(animPtr + 4 * (uint64_t)keyframe);
+			unsigned int _v56_intPtr = (unsigned int)READ(chunk.Get(animPtr + 4 * (uint64_t)keyframe, 4), int32_t);
 			_v56_intPtr = BYTESWAP_INT32(_v56_intPtr);
 
 			gameAddr animPtr_2 = animPtr + _v56_intPtr;
@@ -528,7 +554,7 @@ namespace TAnimUtils
 			{
 				for (int i = 0; i < 3; ++i)
 				{
-					Byte v58 = process.readInt8(animPtr_2);
+					Byte v58 = READ(chunk.Get(animPtr_2, 1), int8_t);
 					int offsetStep = v58 / 4;
 					animPtr_2 += offsetStep;
 				}
@@ -540,14 +566,15 @@ namespace TAnimUtils
 		uint64_t get64AnimSize_LittleEndian(const GameProcess& process, gameAddr anim)
 		{
 			// Do all calculations in uint64_t that way i don't have to pay attention to possible overflows
+			s_processChunk chunk{ process };
 
-			uint64_t boneCount = process.readInt16(anim + 2);
+			uint64_t boneCount = READ(chunk.Get(anim + 2, 2), int16_t);
 
 			uint64_t postBoneDescriptor_offset = (4 + boneCount * sizeof(uint16_t));
 			gameAddr anim_postBoneDescriptorAddr = (gameAddr)(anim + postBoneDescriptor_offset);
 
-			uint64_t animLength = (uint16_t)process.readInt16(anim_postBoneDescriptorAddr);
-			uint64_t __unknown__ = (uint16_t)process.readInt16(anim_postBoneDescriptorAddr + 4);
+			uint64_t animLength = (uint16_t)READ(chunk.Get(anim_postBoneDescriptorAddr, 2), int16_t);
+			uint64_t __unknown__ = (uint16_t)READ(chunk.Get(anim_postBoneDescriptorAddr + 4, 2), int16_t);
 
 			uint64_t vv73 = 2 * ((4 * __unknown__ + 6) / 2);
 			uint64_t aa4 = 6 * (__unknown__ + boneCount);
@@ -556,7 +583,7 @@ namespace TAnimUtils
 
 			unsigned int baseFrame = (unsigned int)animLength - (animLength >= 2 ? 2 : 1);
 			unsigned int keyframe = baseFrame / 16;
-			unsigned int _v56_intPtr = (unsigned int)process.readInt32(animPtr + 4 * (uint64_t)keyframe);
+			unsigned int _v56_intPtr = (unsigned int)READ(chunk.Get(animPtr + 4 * (uint64_t)keyframe, 4), int32_t);
 
 			gameAddr animPtr_2 = animPtr + _v56_intPtr;
 			int lastArg_copy = (int)boneCount;
@@ -565,7 +592,7 @@ namespace TAnimUtils
 			{
 				for (int i = 0; i < 3; ++i)
 				{
-					Byte v58 = process.readInt8(animPtr_2);
+					Byte v58 = READ(chunk.Get(animPtr_2, 1), int8_t);
 					int offsetStep = v58 / 4;
 					animPtr_2 += offsetStep;
 				}
@@ -579,13 +606,14 @@ namespace TAnimUtils
 		uint64_t getT5_64AnimSize_BigEndian(const GameProcess& process, gameAddr anim)
 		{
 			// Do all calculations in uint64_t that way i don't have to pay attention to possible overflows
+			s_processChunk chunk{ process };
 
 			uint64_t boneCount = 0x17;
 
 			gameAddr anim_postBoneDescriptorAddr = anim;
 
-			uint64_t animLength = process.readUInt16(anim_postBoneDescriptorAddr);
-			uint64_t __unknown__ = process.readUInt16(anim_postBoneDescriptorAddr + 4);
+			uint64_t animLength = READ(chunk.Get(anim_postBoneDescriptorAddr, 2), uint16_t);
+			uint64_t __unknown__ = READ(chunk.Get(anim_postBoneDescriptorAddr + 4, 2), uint16_t);
 			animLength = BYTESWAP_INT16(animLength);
 			__unknown__ = BYTESWAP_INT16(__unknown__);
 
@@ -596,7 +624,7 @@ namespace TAnimUtils
 
 			unsigned int baseFrame = (unsigned int)animLength - (animLength >= 2 ? 2 : 1);
 			unsigned int keyframe = baseFrame / 16;
-			unsigned int _v56_intPtr = (unsigned int)process.readInt32(animPtr + 4 * (uint64_t)keyframe);
+			unsigned int _v56_intPtr = (unsigned int)READ(chunk.Get(animPtr + 4 * (uint64_t)keyframe, 4), int32_t);
 			_v56_intPtr = BYTESWAP_INT32(_v56_intPtr);
 
 			gameAddr animPtr_2 = animPtr + _v56_intPtr;
@@ -606,7 +634,7 @@ namespace TAnimUtils
 			{
 				for (int i = 0; i < 3; ++i)
 				{
-					Byte v58 = process.readInt8(animPtr_2);
+					Byte v58 = READ(chunk.Get(animPtr_2, 1), int8_t);
 					int offsetStep = v58 / 4;
 					animPtr_2 += offsetStep;
 				}
@@ -618,13 +646,14 @@ namespace TAnimUtils
 		uint64_t getT5_64AnimSize_LittleEndian(const GameProcess& process, gameAddr anim)
 		{
 			// Do all calculations in uint64_t that way i don't have to pay attention to possible overflows
+			s_processChunk chunk{ process };
 
 			uint64_t boneCount = 0x17;
 
 			gameAddr anim_postBoneDescriptorAddr = anim;
 
-			uint64_t animLength = process.readUInt16(anim_postBoneDescriptorAddr);
-			uint64_t __unknown__ = process.readUInt16(anim_postBoneDescriptorAddr + 4);
+			uint64_t animLength = READ(chunk.Get(anim_postBoneDescriptorAddr, 2), uint16_t);
+			uint64_t __unknown__ = READ(chunk.Get(anim_postBoneDescriptorAddr + 4, 2), uint16_t);
 
 			uint64_t vv73 = 2 * ((4 * __unknown__ + 6) / 2);
 			uint64_t aa4 = 6 * (__unknown__ + boneCount);
@@ -633,7 +662,7 @@ namespace TAnimUtils
 
 			unsigned int baseFrame = (unsigned int)animLength - (animLength >= 2 ? 2 : 1);
 			unsigned int keyframe = baseFrame / 16;
-			unsigned int _v56_intPtr = (unsigned int)process.readInt32(animPtr + 4 * (uint64_t)keyframe);
+			unsigned int _v56_intPtr = (unsigned int)READ(chunk.Get(animPtr + 4 * (uint64_t)keyframe, 4), int32_t);
 
 			gameAddr animPtr_2 = animPtr + _v56_intPtr;
 			int lastArg_copy = (int)boneCount;
@@ -642,7 +671,7 @@ namespace TAnimUtils
 			{
 				for (int i = 0; i < 3; ++i)
 				{
-					Byte v58 = process.readInt8(animPtr_2);
+					Byte v58 = READ(chunk.Get(animPtr_2, 1), int8_t);
 					int offsetStep = v58 / 4;
 					animPtr_2 += offsetStep;
 				}
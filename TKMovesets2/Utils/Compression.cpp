@@ -1,11 +1,17 @@
 #include <lz4.h>
+#include <zstd.h>
 #include <filesystem>
 #include <fstream>
 #include <lzma.h>
+#include <map>
+#include <atomic>
+#include <algorithm>
 
 #include "Compression.hpp"
+#include "helpers.hpp"
 
 #include "MovesetStructs.h"
+#include "constants.h"
 
 // -- Available compression settings across the software -- //
 
@@ -26,6 +32,12 @@ const s_compressionTypes g_compressionTypes[] = {
 		.name = "LZ4",
 		.compressionSetting = TKMovesetCompressionType_LZ4,
 		.extractSetting = ExtractSettings_CompressLZ4
+	},
+
+	{
+		.name = "ZSTD",
+		.compressionSetting = TKMovesetCompressionType_ZSTD,
+		.extractSetting = ExtractSettings_CompressZSTD
 	}
 };
 const size_t g_compressionTypes_len = _countof(g_compressionTypes);
@@ -423,6 +435,408 @@ static bool lzma_decompress(lzma_stream* strm, const Byte* compressed_data, uint
 	}
 }
 
+// -- Moveset frames utils -- //
+
+// Frame to compress, along with where to find its data
+struct s_movesetFrame
+{
+	TKMovesetFrame frame;
+	// Decompressed data of the frame. Can be shorter than the frame, in which case the rest is zero padding.
+	const Byte* data;
+	uint64_t data_size;
+	// Compressed data of the frame, allocated during compression
+	Byte* compressed = nullptr;
+};
+
+// Cuts [data_size] bytes at [data] into frames of MOVESET_COMPRESSION_FRAME_SIZE at most
+// [offset] is where the data starts within the moveset data, [aligned_size] is the size of the data including its padding
+static void AddMovesetFrames(std::vector<s_movesetFrame>& frames, const Byte* data, uint64_t data_size, uint64_t offset, uint64_t aligned_size)
+{
+	for (uint64_t pos = 0; pos < aligned_size; pos += MOVESET_COMPRESSION_FRAME_SIZE)
+	{
+		uint64_t size = std::min(aligned_size - pos, (uint64_t)MOVESET_COMPRESSION_FRAME_SIZE);
+		frames.push_back({
+			.frame = {
+				.compressed_offset = 0,
+				.compressed_size = 0,
+				.offset = offset + pos,
+				.size = size
+			},
+			.data = data + pos,
+			.data_size = pos >= data_size ? 0 : std::min(data_size - pos, size)
+		});
+	}
+}
+
+// Builds the list of frames to cut the moveset data into: one frame per block, with big blocks split further
+// Frames are independent from each other, which allows compressing & decompressing them in parallel
+static std::vector<s_movesetFrame> GetMovesetFrameList(const Byte* header_area, const Byte* moveset_data, uint64_t moveset_data_size)
+{
+	const TKMovesetHeader* header = (TKMovesetHeader*)header_area;
+	std::vector<uint64_t> boundaries = { 0, moveset_data_size };
+
+	if (header->GetBlockListEnd() <= header->moveset_data_start)
+	{
+		const uint64_t* blockList = (uint64_t*)(header_area + header->block_list);
+		for (uint32_t i = 0; i < header->block_list_size; ++i) {
+			if (blockList[i] < moveset_data_size) {
+				boundaries.push_back(blockList[i]);
+			}
+		}
+	}
+
+	std::sort(boundaries.begin(), boundaries.end());
+	boundaries.erase(std::unique(boundaries.begin(), boundaries.end()), boundaries.end());
+
+	std::vector<s_movesetFrame> frames;
+	for (size_t i = 0; i + 1 < boundaries.size(); ++i)
+	{
+		uint64_t blockSize = boundaries[i + 1] - boundaries[i];
+		AddMovesetFrames(frames, moveset_data + boundaries[i], blockSize, boundaries[i], blockSize);
+	}
+
+	return frames;
+}
+
+// Builds the header area & the list of frames of a moveset provided as a list of blocks, each 8 bytes aligned, header first
+// Blocks located before moveset_data_start are copied into the header area, the others are cut into frames without any copy
+static bool GetMovesetFrameList(const std::vector<std::pair<Byte*, uint64_t>>& blocks, std::vector<Byte>& header_area, std::vector<s_movesetFrame>& frames, uint64_t& moveset_data_size)
+{
+	if (blocks.size() == 0 || blocks[0].second < sizeof(TKMovesetHeader)) {
+		return false;
+	}
+
+	const TKMovesetHeader* header = (TKMovesetHeader*)blocks[0].first;
+	const uint64_t moveset_data_start = header->moveset_data_start;
+	header_area.assign(moveset_data_start, 0);
+
+	uint64_t offset = 0;
+	for (const std::pair<Byte*, uint64_t>& block : blocks)
+	{
+		uint64_t alignedSize = Helpers::align8Bytes(block.second);
+
+		if (offset < moveset_data_start)
+		{
+			if (offset + block.second > moveset_data_start) {
+				DEBUG_ERR("Compression: block at offset %llu overlaps the moveset data start", offset);
+				return false;
+			}
+			memcpy(header_area.data() + offset, block.first, block.second);
+		}
+		else {
+			AddMovesetFrames(frames, block.first, block.second, offset - moveset_data_start, alignedSize);
+		}
+
+		offset += alignedSize;
+	}
+
+	moveset_data_size = offset < moveset_data_start ? 0 : offset - moveset_data_start;
+	return true;
+}
+
+// Returns the maximum size a frame of the given size can take once compressed
+static uint64_t GetCompressionBound(TKMovesetCompressionType_ compressionType, uint64_t input_size)
+{
+	switch (compressionType)
+	{
+	case TKMovesetCompressionType_LZ4:
+		return input_size > LZ4_MAX_INPUT_SIZE ? 0 : LZ4_compressBound((int)input_size);
+	case TKMovesetCompressionType_LZMA:
+		return lzma_stream_buffer_bound(input_size);
+	case TKMovesetCompressionType_ZSTD:
+		return ZSTD_compressBound(input_size);
+	default:
+		return 0;
+	}
+}
+
+static uint64_t CompressFrame(TKMovesetCompressionType_ compressionType, const Byte* input_data, uint64_t input_size, Byte* output_buffer, uint64_t output_bufsize)
+{
+	switch (compressionType)
+	{
+	case TKMovesetCompressionType_LZ4:
+		return CompressionUtils::RAW::LZ4::CompressToBuffer(input_data, input_size, output_buffer, output_bufsize);
+	case TKMovesetCompressionType_LZMA:
+		return CompressionUtils::RAW::LZMA::CompressToBuffer(input_data, input_size, output_buffer, output_bufsize, 0);
+	case TKMovesetCompressionType_ZSTD:
+		return CompressionUtils::RAW::ZSTD::CompressToBuffer(input_data, input_size, output_buffer, output_bufsize);
+	default:
+		DEBUG_LOG("Unhandled compression type '%u'\n", compressionType);
+		return 0;
+	}
+}
+
+static bool DecompressFrame(TKMovesetCompressionType_ compressionType, const Byte* compressed_data, uint64_t compressed_size, Byte* output_buffer, uint64_t decompressed_size)
+{
+	switch (compressionType)
+	{
+	case TKMovesetCompressionType_LZ4:
+		return CompressionUtils::RAW::LZ4::DecompressToBuffer(compressed_data, compressed_size, output_buffer, decompressed_size);
+	case TKMovesetCompressionType_LZMA:
+		return CompressionUtils::RAW::LZMA::DecompressToBuffer(compressed_data, compressed_size, output_buffer, decompressed_size);
+	case TKMovesetCompressionType_ZSTD:
+		return CompressionUtils::RAW::ZSTD::DecompressToBuffer(compressed_data, compressed_size, output_buffer, decompressed_size);
+	default:
+		DEBUG_ERR("Moveset decompression: unhandled compression type '%u'", compressionType);
+		return false;
+	}
+}
+
+// Frames of a previously compressed moveset, that identical frames can be copied from instead of being compressed again
+struct s_reusableFrames
+{
+	TKMovesetCompressionType_ compressionType = TKMovesetCompressionType_None;
+	// Compressed moveset data, everything after moveset_data_start
+	std::vector<Byte> compressed_data;
+	// Frames of the moveset, keyed by their decompressed offset
+	std::map<uint64_t, TKMovesetFrame> frames;
+};
+
+// Loads the frames of a moveset file. Returns false if the file can't be read or wasn't compressed in frames.
+static bool LoadReusableFrames(const std::wstring& filename, s_reusableFrames& out)
+{
+	std::ifstream file(filename, std::ios::binary);
+	if (file.fail()) {
+		return false;
+	}
+
+	file.seekg(0, std::ios::end);
+	uint64_t s_file = file.tellg();
+
+	TKMovesetHeader header;
+	if (s_file < sizeof(header)) {
+		return false;
+	}
+
+	file.seekg(0, std::ios::beg);
+	file.read((char*)&header, sizeof(header));
+
+	if (!header.ValidateHeader() || !header.isCompressed() || header.moveset_data_start > s_file || header.moveset_data_start < sizeof(header)) {
+		return false;
+	}
+
+	std::vector<Byte> header_area(header.moveset_data_start);
+	file.seekg(0, std::ios::beg);
+	file.read((char*)header_area.data(), header_area.size());
+
+	const TKMovesetFrameIndex* frameIndex = ((TKMovesetHeader*)header_area.data())->GetFrameIndex();
+	if (frameIndex == nullptr) {
+		return false;
+	}
+
+	out.compressed_data.resize(s_file - header.moveset_data_start);
+	file.read((char*)out.compressed_data.data(), out.compressed_data.size());
+	if (file.fail()) {
+		return false;
+	}
+
+	out.compressionType = header.GetCompressionAlgorithm();
+	for (uint32_t i = 0; i < frameIndex->frame_count; ++i)
+	{
+		const TKMovesetFrame& frame = frameIndex->GetFrames()[i];
+		if (frame.compressed_offset + frame.compressed_size <= out.compressed_data.size()) {
+			out.frames[frame.offset] = frame;
+		}
+	}
+
+	return true;
+}
+
+// Copies the compressed data of the previous frame at the same place if its decompressed content is identical to [input]
+// Decompressing is much faster than compressing, especially with LZMA
+static bool ReuseMovesetFrame(const s_reusableFrames& reusable, s_movesetFrame& frame, const Byte* input)
+{
+	auto it = reusable.frames.find(frame.frame.offset);
+	if (it == reusable.frames.end() || it->second.size != frame.frame.size) {
+		return false;
+	}
+
+	const TKMovesetFrame& previousFrame = it->second;
+	const Byte* previousCompressed = reusable.compressed_data.data() + previousFrame.compressed_offset;
+
+	std::vector<Byte> previousData(previousFrame.size);
+	if (!DecompressFrame(reusable.compressionType, previousCompressed, previousFrame.compressed_size, previousData.data(), previousFrame.size)) {
+		return false;
+	}
+
+	if (memcmp(previousData.data(), input, previousFrame.size) != 0) {
+		return false;
+	}
+
+	try {
+		frame.compressed = new Byte[previousFrame.compressed_size];
+	}
+	catch (std::bad_alloc&) {
+		return false;
+	}
+
+	memcpy(frame.compressed, previousCompressed, previousFrame.compressed_size);
+	frame.frame.compressed_size = previousFrame.compressed_size;
+	return true;
+}
+
+// Compresses every frame in parallel and computes their offsets within the compressed data
+// Frames found identical in [reusable] (if not null) are copied from it instead
+static bool CompressMovesetFrames(std::vector<s_movesetFrame>& frames, TKMovesetCompressionType_ compressionType, const s_reusableFrames* reusable = nullptr)
+{
+	std::atomic<bool> failed = false;
+	std::atomic<size_t> reusedFrames = 0;
+
+	Helpers::ParallelFor(frames.size(), [&](size_t idx) {
+		if (failed) {
+			return;
+		}
+
+		s_movesetFrame& frame = frames[idx];
+		const uint64_t frameSize = frame.frame.size;
+
+		const Byte* input = frame.data;
+		std::vector<Byte> paddedInput;
+		if (frame.data_size < frameSize) {
+			// Frame ends with padding that is not part of the source data
+			paddedInput.assign(frameSize, 0);
+			memcpy(paddedInput.data(), frame.data, frame.data_size);
+			input = paddedInput.data();
+		}
+
+		if (reusable != nullptr && ReuseMovesetFrame(*reusable, frame, input)) {
+			++reusedFrames;
+			return;
+		}
+
+		uint64_t bound = GetCompressionBound(compressionType, frameSize);
+
+		try {
+			frame.compressed = new Byte[bound];
+		}
+		catch (std::bad_alloc&) {
+			DEBUG_ERR("Compression: Failed to allocate %llu bytes for frame %llu", bound, idx);
+			failed = true;
+			return;
+		}
+
+		frame.frame.compressed_size = CompressFrame(compressionType, input, frameSize, frame.compressed, bound);
+		if (frame.frame.compressed_size == 0) {
+			failed = true;
+		}
+	});
+
+	if (reusable != nullptr) {
+		DEBUG_LOG("Compression: Reused %llu/%llu frames from the previous file\n", (uint64_t)reusedFrames, (uint64_t)frames.size());
+	}
+
+	uint64_t compressed_data_size = 0;
+	for (auto& frame : frames) {
+		frame.frame.compressed_offset = compressed_data_size;
+		compressed_data_size += frame.frame.compressed_size;
+	}
+
+	return !failed;
+}
+
+static void FreeMovesetFrames(std::vector<s_movesetFrame>& frames)
+{
+	for (auto& frame : frames) {
+		delete[] frame.compressed;
+		frame.compressed = nullptr;
+	}
+}
+
+// Builds everything that goes before the compressed data: header, properties, block list and frame index
+// The header area is expected to go up to the end of the block list at least
+static std::vector<Byte> GetCompressedMovesetPrefix(const Byte* header_area, const std::vector<s_movesetFrame>& frames, uint64_t moveset_data_size, TKMovesetCompressionType_ compressionType)
+{
+	const uint32_t blockListEnd = ((TKMovesetHeader*)header_area)->GetBlockListEnd();
+	const uint64_t frameIndexSize = sizeof(TKMovesetFrameIndex) + frames.size() * sizeof(TKMovesetFrame);
+	const uint64_t new_moveset_data_start = Helpers::align8Bytes(blockListEnd + frameIndexSize);
+
+	std::vector<Byte> prefix(new_moveset_data_start, 0);
+	memcpy(prefix.data(), header_area, blockListEnd);
+
+	TKMovesetFrameIndex* frameIndex = new(prefix.data() + blockListEnd) TKMovesetFrameIndex;
+	frameIndex->frame_count = (uint32_t)frames.size();
+	for (size_t i = 0; i < frames.size(); ++i) {
+		frameIndex->GetFrames()[i] = frames[i].frame;
+	}
+
+	TKMovesetHeader* new_header = (TKMovesetHeader*)prefix.data();
+	new_header->moveset_data_start = (uint32_t)new_moveset_data_start;
+	new_header->moveset_data_size = moveset_data_size;
+	new_header->compressionType = compressionType | TKMovesetCompressionType_Framed;
+
+	return prefix;
+}
+
+// Compresses every frame of the moveset data in parallel and builds the full compressed moveset
+// The header area (header, properties and block list) is copied as is and followed by the frame index
+static Byte* CompressMoveset(const Byte* header_area, const Byte* moveset_data, uint64_t moveset_data_size, TKMovesetCompressionType_ compressionType, uint64_t& size_out)
+{
+	size_out = 0;
+
+	const TKMovesetHeader* header = (TKMovesetHeader*)header_area;
+	if (header->GetBlockListEnd() > header->moveset_data_start) {
+		DEBUG_ERR("Compression: block list goes past the moveset data start");
+		return nullptr;
+	}
+
+	std::vector<s_movesetFrame> frames = GetMovesetFrameList(header_area, moveset_data, moveset_data_size);
+	Byte* new_moveset = nullptr;
+
+	if (CompressMovesetFrames(frames, compressionType))
+	{
+		std::vector<Byte> prefix = GetCompressedMovesetPrefix(header_area, frames, moveset_data_size, compressionType);
+		uint64_t compressed_data_size = frames.size() == 0 ? 0 : frames.back().frame.compressed_offset + frames.back().frame.compressed_size;
+
+		try {
+			new_moveset = new Byte[prefix.size() + compressed_data_size];
+		}
+		catch (std::bad_alloc&) {
+			DEBUG_ERR("Compression: Failed to allocate %llu bytes", prefix.size() + compressed_data_size);
+		}
+
+		if (new_moveset != nullptr)
+		{
+			memcpy(new_moveset, prefix.data(), prefix.size());
+			for (auto& frame : frames) {
+				memcpy(new_moveset + prefix.size() + frame.frame.compressed_offset, frame.compressed, frame.frame.compressed_size);
+			}
+
+			size_out = prefix.size() + compressed_data_size;
+			DEBUG_LOG("Compression: Old size was %llu, compressed size is %llu (%llu frames), ratio is %.2f%%\n", moveset_data_size, compressed_data_size, frames.size(), (float)compressed_data_size / (float)moveset_data_size);
+		}
+	}
+
+	FreeMovesetFrames(frames);
+	return new_moveset;
+}
+
+// Decompresses every frame of the moveset data in parallel
+static bool DecompressMovesetFrames(const TKMovesetHeader* header, const TKMovesetFrameIndex* frameIndex, const Byte* compressed_data, uint64_t compressed_data_size, Byte* output_buffer)
+{
+	const TKMovesetFrame* frames = frameIndex->GetFrames();
+	const auto compressionType = header->GetCompressionAlgorithm();
+	std::atomic<bool> failed = false;
+
+	Helpers::ParallelFor(frameIndex->frame_count, [&](size_t idx) {
+		if (failed) {
+			return;
+		}
+
+		const TKMovesetFrame& frame = frames[idx];
+		if (frame.compressed_offset + frame.compressed_size > compressed_data_size || frame.offset + frame.size > header->moveset_data_size) {
+			DEBUG_ERR("Moveset decompression: frame %llu is out of bounds", idx);
+			failed = true;
+			return;
+		}
+
+		if (!DecompressFrame(compressionType, compressed_data + frame.compressed_offset, frame.compressed_size, output_buffer + frame.offset, frame.size)) {
+			failed = true;
+		}
+	});
+
+	return !failed;
+}
+
 // -- -- //
 
 namespace CompressionUtils
@@ -483,60 +897,32 @@ namespace CompressionUtils
 
 			bool Compress(const std::wstring& dest_filename, const std::wstring& src_filename, TKMovesetCompressionType_ compressionType)
 			{
-				std::ifstream orig_file(src_filename, std::ios::binary);
-
-				uint32_t moveset_data_start;
-				char* moveset_header_buf;
-				// Copy up to moveset_data_start, get size of moveset data
-				uint64_t moveset_data_size;
-				{
-					// Read header data
-					TKMovesetHeader header;
-					orig_file.seekg(0, std::ios::beg);
-					orig_file.read((char*)&header, sizeof(header));
-
-					moveset_data_start = header.moveset_data_start;
-
-					// Read up to moveset data start (includes header and more)
-                    try {
-                        moveset_header_buf = new char[moveset_data_start];
-                    } catch (std::bad_alloc&) {
-                        return false;
-                    }
-                    
-					orig_file.seekg(0, std::ios::beg);
-					orig_file.read(moveset_header_buf, moveset_data_start);
-
-					// Calculate moveset data size
-					orig_file.seekg(0, std::ios::end);
-					moveset_data_size = (uint64_t)orig_file.tellg() - moveset_data_start;
-
-					// Mark moveset as compressed
-					((TKMovesetHeader*)moveset_header_buf)->compressionType = compressionType;
-					((TKMovesetHeader*)moveset_header_buf)->moveset_data_size = moveset_data_size;
-
-					// Move cursor back to the start of the moveset data
-					orig_file.seekg(moveset_data_start, std::ios::beg);
-				}
+				uint64_t s_moveset;
+				Byte* moveset;
 
-				// Compress moveset data
-				Byte* inbuf;
 				try {
-					inbuf = new Byte[moveset_data_size];
+					moveset = Helpers::ReadMovesetFile(src_filename, s_moveset);
 				}
-				catch (std::bad_alloc&) {
-					DEBUG_ERR("Compress: Failed to allocate %llu bytes", moveset_data_size);
+				catch (std::exception&) {
+					DEBUG_ERR("Compress: Failed to read moveset '%S'", src_filename.c_str());
 					return false;
 				}
 
-				Byte* outbuf = nullptr;
-				orig_file.read((char*)inbuf, moveset_data_size);
-				orig_file.close();
+				const TKMovesetHeader* header = (TKMovesetHeader*)moveset;
+				if (header->isCompressed()) {
+					DEBUG_LOG("Can't compress already compressed movesets.\n");
+					free(moveset);
+					return false;
+				}
 
-				// Write header
-				std::ofstream new_file(dest_filename, std::ios::binary);
-				new_file.write(moveset_header_buf, moveset_data_start);
-				delete[] moveset_header_buf;
+				uint64_t new_size;
+				Byte* new_moveset = CompressMoveset(moveset, moveset + header->moveset_data_start, s_moveset - header->moveset_data_start, compressionType, new_size);
+				free(moveset);
+
+				if (new_moveset == nullptr) {
+					DEBUG_LOG("Compression failure\n");
+					return false;
+				}
 
 				if (src_filename != dest_filename) {
 					try {
@@ -546,39 +932,55 @@ namespace CompressionUtils
 						DEBUG_ERR("Compression: src file removal error");
 					}
 				}
-				uint64_t compressed_size = 0;
 
-				switch (compressionType)
-				{
-				case TKMovesetCompressionType_LZ4:
-					DEBUG_LOG("Using LZ4 compression type...\n");
-					outbuf = CompressionUtils::RAW::LZ4::Compress(inbuf, moveset_data_size, compressed_size);
-					break;
-				case TKMovesetCompressionType_LZMA:
-					DEBUG_LOG("Using LZMA compression type...\n");
-					outbuf = CompressionUtils::RAW::LZMA::Compress(inbuf, moveset_data_size, compressed_size, 0);
-					break;
+				std::ofstream new_file(dest_filename, std::ios::binary);
+				new_file.write((char*)new_moveset, new_size);
+				bool success = !new_file.fail();
+				new_file.close();
+
+				delete[] new_moveset;
+				return success;
+			}
+
+			bool Compress(const std::wstring& dest_filename, const std::vector<std::pair<Byte*, uint64_t>>& blocks, TKMovesetCompressionType_ compressionType, const std::wstring& previous_filename)
+			{
+				std::vector<Byte> header_area;
+				std::vector<s_movesetFrame> frames;
+				uint64_t moveset_data_size;
 
-				default:
-					DEBUG_LOG("Unhandled compression type '%u'\n", compressionType);
-					break;
+				if (!GetMovesetFrameList(blocks, header_area, frames, moveset_data_size)) {
+					DEBUG_ERR("Compression: invalid moveset block list");
+					return false;
 				}
 
-				DEBUG_LOG("Compression: Old size was %llu, compressed size is %llu, ratio is %.2f%%\n", moveset_data_size, compressed_size, (float)compressed_size / (float)moveset_data_size);
+				if (((TKMovesetHeader*)header_area.data())->GetBlockListEnd() > header_area.size()) {
+					DEBUG_ERR("Compression: block list goes past the moveset data start");
+					return false;
+				}
 
-				if (outbuf == nullptr)
+				// Only frames compressed the same way can be reused
+				s_reusableFrames reusable;
+				bool reuse = previous_filename.size() != 0 && LoadReusableFrames(previous_filename, reusable) && reusable.compressionType == compressionType;
+
+				bool success = false;
+				if (CompressMovesetFrames(frames, compressionType, reuse ? &reusable : nullptr))
 				{
+					std::vector<Byte> prefix = GetCompressedMovesetPrefix(header_area.data(), frames, moveset_data_size, compressionType);
+
+					// Frames are written straight from their own buffers, the compressed moveset is never assembled in memory
+					std::ofstream new_file(dest_filename, std::ios::binary);
+					new_file.write((char*)prefix.data(), prefix.size());
+					for (auto& frame : frames) {
+						new_file.write((char*)frame.compressed, frame.frame.compressed_size);
+					}
+
+					success = !new_file.fail();
 					new_file.close();
-					std::filesystem::remove(dest_filename);
-					DEBUG_LOG("Compression failure\n");
-				}
-				else {
-					new_file.write((char*)outbuf, compressed_size);
+					DEBUG_LOG("Compression: Wrote %llu frames (%llu bytes of moveset data)\n", frames.size(), moveset_data_size);
 				}
 
-				delete[] inbuf;
-				delete[] outbuf;
-				return compressed_size >= 0;
+				FreeMovesetFrames(frames);
+				return success;
 			}
 		};
 	};
@@ -590,36 +992,27 @@ namespace CompressionUtils
 			Byte* Decompress(const Byte* moveset, uint64_t compressed_data_size, uint64_t& size_out)
 			{
 				TKMovesetHeader* header = (TKMovesetHeader*)moveset;
+				size_out = 0;
 
 				if (!header->isCompressed()) {
 					return nullptr;
 				}
 
-				const Byte* moveset_data_start = moveset + header->moveset_data_start;
-				size_out = header->moveset_data_size;
-				Byte* result = nullptr;
-
-				switch (header->compressionType)
-				{
-				case TKMovesetCompressionType_LZ4:
-					result = CompressionUtils::RAW::LZ4::Decompress(moveset_data_start, compressed_data_size, header->moveset_data_size);
-					break;
-				case TKMovesetCompressionType_LZMA:
-					result = CompressionUtils::RAW::LZMA::Decompress(moveset_data_start, compressed_data_size, header->moveset_data_size);
-					break;
-				default:
-					size_out = 0;
-					DEBUG_ERR("Moveset decompression: unhandled compression type '%u'", header->compressionType);
+				Byte* result;
+				try {
+					result = new Byte[header->moveset_data_size];
+				}
+				catch (std::bad_alloc&) {
+					DEBUG_ERR("Moveset decompression: Failed to allocate %llu bytes", header->moveset_data_size);
 					return nullptr;
-					break;
 				}
 
-				if (result == nullptr) {
-					DEBUG_ERR("Error during decompression");
+				if (!DecompressToBuffer(moveset, compressed_data_size, result)) {
+					delete[] result;
+					return nullptr;
 				}
 
-				DEBUG_LOG("Decompressed moveset, compressed size was %llu, size_out is %llu\n", compressed_data_size, size_out);
-
+				size_out = header->moveset_data_size;
 				return result;
 			}
 
@@ -632,20 +1025,19 @@ namespace CompressionUtils
 				}
 
 				const Byte* moveset_data_start = moveset + header->moveset_data_start;
-				bool result = false;
+				const TKMovesetFrameIndex* frameIndex = header->GetFrameIndex();
+				bool result;
 
-				switch (header->compressionType)
-				{
-				case TKMovesetCompressionType_LZ4:
-					result = CompressionUtils::RAW::LZ4::DecompressToBuffer(moveset_data_start, compressed_data_size, output_buffer, header->moveset_data_size);
-					break;
-				case TKMovesetCompressionType_LZMA:
-					result = CompressionUtils::RAW::LZMA::DecompressToBuffer(moveset_data_start, compressed_data_size, output_buffer, header->moveset_data_size);
-					break;
-				default:
-					DEBUG_ERR("Moveset decompression: unhandled compression type '%u'", header->compressionType);
-					return false;
-					break;
+				if (frameIndex != nullptr) {
+					result = DecompressMovesetFrames(header, frameIndex, moveset_data_start, compressed_data_size, output_buffer);
+				}
+				else if (header->isFramed()) {
+					DEBUG_ERR("Moveset decompression: missing or invalid frame index");
+					result = false;
+				}
+				else {
+					// Movesets compressed before frames were introduced are made of one single stream
+					result = DecompressFrame(header->GetCompressionAlgorithm(), moveset_data_start, compressed_data_size, output_buffer, header->moveset_data_size);
 				}
 
 				if (result == false) {
@@ -701,41 +1093,11 @@ namespace CompressionUtils
 					return nullptr;
 				}
 
-				const Byte* moveset_data_start = moveset + header->moveset_data_start;
-				uint64_t moveset_data_size = full_size - header->moveset_data_start;
-
-				Byte* new_moveset;
-                
-                try {
-                    new_moveset = new Byte[full_size];
-                } catch (std::bad_alloc&) {
-                    return nullptr;
-                }
-				Byte* new_moveset_data_start = new_moveset + header->moveset_data_start;
-				memcpy(new_moveset, header, sizeof(TKMovesetHeader));
-
-				uint64_t compressionSize = 0;
-				switch (compressionType)
-				{
-				case TKMovesetCompressionType_LZ4:
-					compressionSize = CompressionUtils::RAW::LZ4::CompressToBuffer(moveset_data_start, moveset_data_size, new_moveset_data_start, moveset_data_size);
-					break;
-				case TKMovesetCompressionType_LZMA:
-					compressionSize = CompressionUtils::RAW::LZMA::CompressToBuffer(moveset_data_start, moveset_data_size, new_moveset_data_start, moveset_data_size);
-					break;
-				}
-
-				if (compressionSize == 0) {
-					delete[] new_moveset;
+				if (header->moveset_data_start > full_size) {
 					return nullptr;
 				}
 
-				TKMovesetHeader* new_header = (TKMovesetHeader*)new_moveset;
-				new_header->compressionType = compressionType;
-				new_header->moveset_data_size = moveset_data_size;
-
-				size_out = compressionSize;
-				return new_moveset;
+				return CompressMoveset(moveset, moveset + header->moveset_data_start, full_size - header->moveset_data_start, compressionType, size_out);
 			}
 		};
 
@@ -866,6 +1228,102 @@ namespace CompressionUtils
 			}
 		}
 
+		namespace ZSTD
+		{
+			uint64_t CompressToBuffer(const Byte* input_data, uint64_t input_size, Byte* output_buffer, uint64_t output_bufsize, int level)
+			{
+				if (level < 1) {
+					level = 1;
+				}
+				else if (level > ZSTD_maxCLevel()) {
+					DEBUG_LOG("ZSTD: Level %d is above the maximum level (%d)\n", level, ZSTD_maxCLevel());
+					level = ZSTD_maxCLevel();
+				}
+
+				ZSTD_CCtx* cctx = ZSTD_createCCtx();
+				if (cctx == nullptr) {
+					DEBUG_LOG("ZSTD context creation failure\n");
+					return 0;
+				}
+
+				ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, level);
+				ZSTD_CCtx_setParameter(cctx, ZSTD_c_checksumFlag, 1);
+
+				size_t compressed_size = ZSTD_compress2(cctx, output_buffer, output_bufsize, input_data, input_size);
+				ZSTD_freeCCtx(cctx);
+
+				if (ZSTD_isError(compressed_size)) {
+					DEBUG_LOG("ZSTD Compression failure: %s\n", ZSTD_getErrorName(compressed_size));
+					return 0;
+				}
+
+				return compressed_size;
+			}
+
+			bool DecompressToBuffer(const Byte* compressed_data, uint64_t compressed_size, Byte* output_buffer, uint64_t decompressed_size)
+			{
+				ZSTD_DCtx* dctx = ZSTD_createDCtx();
+				if (dctx == nullptr) {
+					DEBUG_LOG("ZSTD context creation failure\n");
+					return false;
+				}
+
+				size_t result = ZSTD_decompressDCtx(dctx, output_buffer, decompressed_size, compressed_data, compressed_size);
+				ZSTD_freeDCtx(dctx);
+
+				if (ZSTD_isError(result) || result != decompressed_size)
+				{
+					DEBUG_LOG("ZSTD Decompression failure: %s\n", ZSTD_isError(result) ? ZSTD_getErrorName(result) : "size mismatch");
+					return false;
+				}
+
+				return true;
+			}
+
+			Byte* Compress(const Byte* input_data, uint64_t input_size, uint64_t& size_out, int level)
+			{
+				Byte* result;
+				size_out = 0;
+
+				try {
+					result = new Byte[input_size];
+				}
+				catch (std::bad_alloc&) {
+					DEBUG_ERR("Failed to allocate %llu bytes for compressed data", input_size);
+					return nullptr;
+				}
+
+				size_out = CompressToBuffer(input_data, input_size, result, input_size, level);
+
+				if (size_out == 0) {
+					delete[] result;
+					return nullptr;
+				}
+
+				return result;
+			}
+
+			Byte* Decompress(const Byte* compressed_data, uint64_t compressed_size, uint64_t decompressed_size)
+			{
+				Byte* result;
+
+				try {
+					result = new Byte[decompressed_size];
+				}
+				catch (std::bad_alloc&) {
+					DEBUG_ERR("Failed to allocate %llu bytes for decompressed data", decompressed_size);
+					return nullptr;
+				}
+
+				if (!DecompressToBuffer(compressed_data, compressed_size, result, decompressed_size)) {
+					delete[] result;
+					return nullptr;
+				}
+
+				return result;
+			}
+		};
+
 		namespace LZ4
 		{
 			uint64_t CompressToBuffer(const Byte* input_data, uint64_t input_size, Byte* output_buffer, uint64_t output_bufsize)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "ExtractorSettings.hpp"
 
@@ -32,11 +33,15 @@ namespace CompressionUtils
 			bool Compress(const std::wstring& dest_filename, TKMovesetCompressionType_ compressionType);
 			// Compress a moveset from file to file
 			bool Compress(const std::wstring& dest_filename, const std::wstring& src_filename, TKMovesetCompressionType_ compressionType);
+			// Compress a moveset from a list of blocks, each 8 bytes aligned & starting with the header, to a file
+			// If [previous_filename] is a moveset compressed the same way, frames whose content did not change are copied from it instead of being compressed again
+			bool Compress(const std::wstring& dest_filename, const std::vector<std::pair<Byte*, uint64_t>>& blocks, TKMovesetCompressionType_ compressionType, const std::wstring& previous_filename = L"");
 		};
 	};
 
 	namespace RAW {
 		// Tools to decompress moveset specifically, will adapt to the moveset's compression algorithm indicated in the header
+		// Movesets are compressed in independent frames (see TKMovesetFrameIndex) that are processed in parallel
 		namespace Moveset {
 			// Decompress moveset (keeps header in the final allocated memory area)
 			Byte* DecompressWithHeader(const Byte* moveset, uint64_t compressed_data_size, uint64_t& size_out);
@@ -45,7 +50,7 @@ namespace CompressionUtils
 			// Decompress a moveset (without keeping header) to a previously allocated buffer
 			bool DecompressToBuffer(const Byte* moveset, uint64_t compressed_data_size, Byte* output_buffer);
 			
-			// Compress the moveset from memory to memory
+			// Compress the moveset from memory to memory. size_out is the size of the whole compressed moveset, header included
 			Byte* Compress(const Byte* moveset, uint64_t full_size, TKMovesetCompressionType_ compressionType, uint64_t& size_out);
 		};
 
@@ -64,6 +69,21 @@ namespace CompressionUtils
 			Byte* Decompress(const Byte* compressed_data, uint64_t compressed_size, uint64_t decompressed_size);
 		};
 
+		// Zstandard, decompresses nearly as fast as LZ4 while compressing close to LZMA
+		// Level can be between 1 and 22 included. Levels above 19 use a lot more memory for little gain.
+		// No dictionary is used: moveset files are shared and sent online, they must be decodable by any build
+		namespace ZSTD {
+			// Compress without allocation
+			uint64_t CompressToBuffer(const Byte* input_data, uint64_t input_size, Byte* output_buffer, uint64_t output_bufsize, int level = 15);
+			// Compress with allocation
+			Byte* Compress(const Byte* input_data, uint64_t input_size, uint64_t& size_out, int level = 15);
+
+			// Decompress without allocation
+			bool DecompressToBuffer(const Byte* compressed_data, uint64_t compressed_size, Byte* output_buffer, uint64_t decompressed_size);
+			// Decompress with allocation
+			Byte* Decompress(const Byte* compressed_data, uint64_t compressed_size, uint64_t decompressed_size);
+		};
+
 		// LZ4, very quick with viable compression (about 33% for T movesets)
 		namespace LZ4 {
 			// Compress without allocation
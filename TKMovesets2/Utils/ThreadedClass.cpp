@@ -18,6 +18,26 @@ void ThreadedClass::StopThreadAndCleanup()
 	if (m_threadStarted)
 	{
 		m_threadStarted = false;
+		WakeThread();
 		m_t.join();
 	}
+}
+
+void ThreadedClass::WakeThread()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_wakeMutex);
+		m_wakeRequested = true;
+	}
+	m_wakeCondition.notify_all();
+}
+
+// -- Protected functions -- //
+
+bool ThreadedClass::SleepFor(std::chrono::milliseconds duration)
+{
+	std::unique_lock<std::mutex> lock(m_wakeMutex);
+	bool woken = m_wakeCondition.wait_for(lock, duration, [this]() { return m_wakeRequested; });
+	m_wakeRequested = false;
+	return woken;
 }
\ No newline at end of file
@@ -1,17 +1,33 @@
 #pragma once
 
 #include <thread>
+#include <mutex>
+#include <chrono>
+#include <condition_variable>
 
 class ThreadedClass
 {
+private:
+	// Protects m_wakeRequested
+	std::mutex m_wakeMutex;
+	// Notified by WakeThread() to interrupt SleepFor()
+	std::condition_variable m_wakeCondition;
+	// Set by WakeThread() so that a wake up requested while the thread isn't sleeping isn't lost
+	bool m_wakeRequested = false;
+
 protected:
 	// Is a thread running
 	bool m_threadStarted = false;
 	// The thread that will run the Update() function regularly
 	std::thread m_t;
 
+	// Blocks the thread for [duration], or until WakeThread() is called. Returns true if it was woken up early.
+	bool SleepFor(std::chrono::milliseconds duration);
+
 public:
 	virtual void StartThread();
 	virtual void Update() = 0;
 	virtual void StopThreadAndCleanup();
-};
\ No newline at end of file
+	// Makes the thread run its next iteration right away instead of waiting for its current sleep to end
+	virtual void WakeThread();
+};
@@ -18,6 +18,12 @@
 # define UPDATE_REPO_URL         "https://github.com/Kiloutre/TKMovesets"
 
 # define INTERFACE_DATA_DIR      "TKMInterface"
+# define MOVESET_LIBRARY_INDEX   INTERFACE_DATA_DIR "/moveset_library.idx"
+# define MOVESET_LIBRARY_SCAN_THREADS (16) // Amount of moveset headers read at once when listing movesets
+# define EXTRACTION_SNAPSHOT_DIR INTERFACE_DATA_DIR "/snapshots"
+# define AOB_SCAN_CACHE_FILE     INTERFACE_DATA_DIR "/aob_scan_cache.txt"
+# define EXTRACTION_SNAPSHOT_EXTENSION ".tkmsnap"
+# define CONVERSION_CACHE_DIR    INTERFACE_DATA_DIR "/conversion_cache"
 # define GAME_ADDRESSES_FILE     "game_addresses.ini"
 # define SETTINGS_FILE           "TKMSettings.ini"
 
@@ -27,6 +33,8 @@
 
 // Arbitrary max block size in case something bad happened during extraction and we get a very invalid block
 # define MOVESET_MAX_BLOCK_SIZE_MB       (50)
+// Blocks bigger than this are split in multiple frames when compressing, allowing more of them to be (de)compressed in parallel
+# define MOVESET_COMPRESSION_FRAME_SIZE  (2 * 1024 * 1024)
 
 # define MOVESET_EXTRACTED_NAME_PREFIX   "Tkm:"
 # define MOVESET_CUSTOM_MOVE_NAME_PREFIX "tkm_"
@@ -37,6 +45,8 @@
 # define MOVESET_TMPFILENAME_EXTENSION   "._tmp_tkmvst"
 // We might update extractors/importers without touching the main tool, so this is separated
 # define MOVESET_VERSION_STRING          "1.0"
+// Increment when the output of a moveset converter changes, previously cached conversions are then ignored
+# define MOVESET_CONVERTER_VERSION       (1)
 // Accepted chars in header strings are alphanum + those specified here
 // Anything else indicate a malformed header : a bad file
 # define MOVESET_HEADER_STRING_CHARSET   "_-+!()[]{}.,;: /"
@@ -59,6 +69,15 @@
 
 # define GAME_FREEING_DELAY_SEC           (10)
 # define GAME_INTERACTION_THREAD_SLEEP_MS (200)
+# define GAME_INTERACTION_THREAD_MAX_SLEEP_MS (2000) // Attachment attempts are slowed down up to this interval while the game isn't running
+# define GAME_READ_CACHE_PAGE_SIZE        (4096) // Granularity of the process read cache
+# define GAME_READ_CACHE_MAX_READ         (GAME_READ_CACHE_PAGE_SIZE) // Reads bigger than this bypass the read cache
+# define GAME_READ_CACHE_MAX_PAGES        (16384) // The read cache is cleared when reaching this many pages (64MB)
+# define EXTRACTION_MAX_PARALLEL_JOBS     (4) // Amount of queued extractions ran at once
+# define CONVERSION_CACHE_MAX_ENTRIES     (8) // Amount of converted movesets kept in memory
+# define CONVERSION_CACHE_MAX_FILES       (64) // Amount of converted movesets kept on disk, the oldest ones are deleted past this
+# define AOB_SCAN_WINDOW_SIZE             (1024 * 1024) // Amount of module memory read and scanned at once by AOB scans
+# define MOVESET_DIRECTORY_WATCH_BUFSIZE  (16384) // Size of the buffer receiving the moveset directory change notifications
 # define EDITOR_BACKUP_FREQUENCY_MINUTES  (20)
 
 # define MAX_FPS                       (60.0f)
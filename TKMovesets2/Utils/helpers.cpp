@@ -3,6 +3,16 @@
 #include <chrono>
 #include <codecvt>
 #include <cctype>
+#include <atomic>
+#include <thread>
+#include <immintrin.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+# define BYTESWAP_TARGET_SSSE3
+#else
+# define BYTESWAP_TARGET_SSSE3 __attribute__((target("ssse3")))
+#endif
 
 #include "helpers.hpp"
 
@@ -34,6 +44,205 @@ namespace ByteswapHelpers
 	}
 }
 
+// -- Byteswap layouts -- //
+
+static bool CpuSupportsSSSE3()
+{
+#ifdef _MSC_VER
+	int info[4];
+	__cpuid(info, 1);
+	return (info[2] & (1 << 9)) != 0;
+#else
+	return __builtin_cpu_supports("ssse3");
+#endif
+}
+
+ByteswapLayout::ByteswapLayout(uint64_t structSize, const ByteswapField* fields, size_t fieldCount) : m_structSize(structSize), m_fields(fields, fields + fieldCount)
+{
+	static const bool supportsSSSE3 = CpuSupportsSSSE3();
+	m_canShuffle = supportsSSSE3;
+
+	const uint64_t chunkCount = (structSize + 15) / 16;
+	m_shuffleMasks.resize(chunkCount * 16);
+	for (uint64_t i = 0; i < m_shuffleMasks.size(); ++i) {
+		m_shuffleMasks[i] = (Byte)(i % 16);
+	}
+
+	std::vector<bool> usedChunks(chunkCount, false);
+	for (auto& field : m_fields)
+	{
+		for (uint32_t valueIdx = 0; valueIdx < field.count; ++valueIdx)
+		{
+			uint64_t valueStart = field.offset + (uint64_t)valueIdx * field.size;
+			uint64_t valueEnd = valueStart + field.size - 1;
+
+			if (valueStart / 16 != valueEnd / 16) {
+				m_canShuffle = false;
+				continue;
+			}
+
+			for (uint64_t i = 0; i < field.size; ++i) {
+				m_shuffleMasks[valueStart + i] = (Byte)((valueEnd - i) % 16);
+			}
+			usedChunks[valueStart / 16] = true;
+		}
+	}
+
+	for (uint32_t i = 0; i < chunkCount; ++i)
+	{
+		if (usedChunks[i]) {
+			m_chunks.push_back(i);
+		}
+	}
+
+	if (m_canShuffle)
+	{
+		// Swap two structures filled with distinct bytes both ways, the second one goes through the end-of-list path
+		std::vector<Byte> shuffled(structSize * 2);
+		for (size_t i = 0; i < shuffled.size(); ++i) {
+			shuffled[i] = (Byte)i;
+		}
+		std::vector<Byte> expected = shuffled;
+
+		SwapWithShuffles(shuffled.data(), 2);
+		SwapScalar(expected.data(), 2);
+
+		if (shuffled != expected) {
+			DEBUG_ERR("ByteswapLayout: shuffles don't match per-member swaps for a structure of size %llu", structSize);
+			m_canShuffle = false;
+		}
+	}
+}
+
+BYTESWAP_TARGET_SSSE3
+void ByteswapLayout::SwapWithShuffles(Byte* list, uint64_t amount) const
+{
+	const Byte* listEnd = list + m_structSize * amount;
+
+	for (uint64_t structIdx = 0; structIdx < amount; ++structIdx)
+	{
+		Byte* structure = list + structIdx * m_structSize;
+
+		for (uint32_t chunk : m_chunks)
+		{
+			Byte* chunkStart = structure + chunk * 16;
+			__m128i mask = _mm_loadu_si128((const __m128i*)&m_shuffleMasks[chunk * 16]);
+
+			// Bytes past the structure are left in place by the mask, so the chunk can overlap the next structure
+			if (chunkStart + 16 <= listEnd) {
+				__m128i data = _mm_loadu_si128((const __m128i*)chunkStart);
+				_mm_storeu_si128((__m128i*)chunkStart, _mm_shuffle_epi8(data, mask));
+			}
+			else {
+				// Last chunk of the list: don't touch memory that isn't ours
+				Byte buffer[16] = { 0 };
+				size_t chunkSize = (size_t)(listEnd - chunkStart);
+				memcpy(buffer, chunkStart, chunkSize);
+				_mm_storeu_si128((__m128i*)buffer, _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)buffer), mask));
+				memcpy(chunkStart, buffer, chunkSize);
+			}
+		}
+	}
+}
+
+void ByteswapLayout::SwapScalar(Byte* list, uint64_t amount) const
+{
+	Byte* structure = list;
+	for (uint64_t structIdx = 0; structIdx < amount; ++structIdx)
+	{
+		for (auto& field : m_fields)
+		{
+			for (uint32_t valueIdx = 0; valueIdx < field.count; ++valueIdx)
+			{
+				Byte* value = structure + field.offset + (uint64_t)valueIdx * field.size;
+				switch (field.size)
+				{
+				case 2:
+					ByteswapHelpers::SWAP_INT16(value);
+					break;
+				case 4:
+					ByteswapHelpers::SWAP_INT32(value);
+					break;
+				case 8:
+					ByteswapHelpers::SWAP_INT64(value);
+					break;
+				}
+			}
+		}
+		structure += m_structSize;
+	}
+}
+
+void ByteswapLayout::Swap(void* list, uint64_t amount) const
+{
+	if (m_canShuffle) {
+		SwapWithShuffles((Byte*)list, amount);
+	}
+	else {
+		SwapScalar((Byte*)list, amount);
+	}
+}
+
+
+// -- CRC32 utils -- //
+
+// Slice-by-8 tables. [0] is the regular byte-wise table, [n] is [n-1] advanced by one more zero byte
+static const uint32_t (&GetCrc32Tables())[8][256]
+{
+	static const struct s_crc32Tables
+	{
+		uint32_t tables[8][256];
+
+		s_crc32Tables()
+		{
+			const uint32_t polynomial = 0xEDB88320;
+			for (uint32_t i = 0; i < 256; i++)
+			{
+				uint32_t c = i;
+				for (size_t j = 0; j < 8; j++)
+				{
+					if (c & 1) {
+						c = polynomial ^ (c >> 1);
+					}
+					else {
+						c >>= 1;
+					}
+				}
+				tables[0][i] = c;
+			}
+
+			for (uint32_t i = 0; i < 256; i++) {
+				for (size_t k = 1; k < 8; k++) {
+					tables[k][i] = (tables[k - 1][i] >> 8) ^ tables[0][tables[k - 1][i] & 0xFF];
+				}
+			}
+		}
+	} s_tables;
+
+	return s_tables.tables;
+}
+
+static uint32_t gf2_matrix_times(const uint32_t* mat, uint32_t vec)
+{
+	uint32_t sum = 0;
+	while (vec) {
+		if (vec & 1) {
+			sum ^= *mat;
+		}
+		vec >>= 1;
+		mat++;
+	}
+	return sum;
+}
+
+static void gf2_matrix_square(uint32_t* square, const uint32_t* mat)
+{
+	for (unsigned int n = 0; n < 32; n++) {
+		square[n] = gf2_matrix_times(mat, mat[n]);
+	}
+}
+
+// -- -- //
 
 namespace Helpers
 {
@@ -79,16 +288,14 @@ namespace Helpers
 	uint32_t CalculateCrc32(const std::vector<std::pair<Byte*, uint64_t>>& blocks)
 	{
 		uint32_t crc32 = 0;
-		uint32_t table[256];
 
-		Helpers::crc32_generate_table(table);
 		for (size_t i = 0; i < blocks.size(); ++i) {
 			char* blockData = (char*)blocks[i].first;
 			uint64_t blockSize = blocks[i].second;
 
-			crc32 = Helpers::crc32_update(table, crc32, blockData, blockSize);
+			crc32 = Helpers::crc32_update(crc32, blockData, blockSize);
 #ifdef BUILD_TYPE_DEBUG
-			uint32_t single_crc32 = Helpers::crc32_update(table, 0, blockData, blockSize);
+			uint32_t single_crc32 = Helpers::crc32_update(0, blockData, blockSize);
 			DEBUG_LOG("(CRC32 = %x) - Block %llx (size %llx)\n", single_crc32, (uint64_t)blockData, blockSize);
 #endif
 		}
@@ -97,13 +304,7 @@ namespace Helpers
 
 	uint32_t CalculateCrc32(const Byte* data, uint64_t size)
 	{
-		uint32_t crc32 = 0;
-		uint32_t table[256];
-
-		Helpers::crc32_generate_table(table);
-		crc32 = Helpers::crc32_update(table, crc32, (char*)data, size);
-
-		return crc32;
+		return Helpers::crc32_update(0, data, size);
 	}
 
 	std::string formatDateTime(uint64_t date, bool path_compatible, bool include_seconds)
@@ -144,6 +345,63 @@ namespace Helpers
 		}
 	}
 
+	void convertPtrsToIndexes(void* listAddr, uint64_t struct_size, uint64_t amount, std::initializer_list<StructPtrField> fields)
+	{
+		// Divisions by a runtime struct size are much slower than the multiplications the compiler would otherwise emit for sizeof()
+		// Precompute ceil(2^64 / size) once per field: the high half of (offset * reciprocal) is then exact for any offset below 2^32
+		uint64_t reciprocals[16];
+		const size_t fieldCount = fields.size() < _countof(reciprocals) ? fields.size() : _countof(reciprocals);
+		{
+			size_t i = 0;
+			for (auto& field : fields)
+			{
+				if (i == fieldCount) break;
+				reciprocals[i++] = (field.structSize <= 1 || (field.structSize >> 32) != 0) ? 0 : (UINT64_MAX / field.structSize) + 1;
+			}
+		}
+
+		Byte* listCursor = (Byte*)listAddr;
+		while (amount-- > 0)
+		{
+			size_t i = 0;
+			for (auto& field : fields)
+			{
+				uint64_t* structMember = (uint64_t*)(listCursor + field.offset);
+				uint64_t offset = *structMember - field.listStart;
+
+				if (*structMember == 0) {
+					*structMember = (uint64_t)-1;
+				}
+				else if (i < fieldCount && reciprocals[i] != 0 && (offset >> 32) == 0) {
+#ifdef _MSC_VER
+					*structMember = __umulh(offset, reciprocals[i]);
+#else
+					*structMember = (uint64_t)(((unsigned __int128)offset * reciprocals[i]) >> 64);
+#endif
+				}
+				else {
+					*structMember = offset / field.structSize;
+				}
+				++i;
+			}
+			listCursor += struct_size;
+		}
+	}
+
+	void convertIndexesToPtrs(void* listAddr, uint64_t struct_size, uint64_t amount, std::initializer_list<StructPtrField> fields)
+	{
+		Byte* listCursor = (Byte*)listAddr;
+		while (amount-- > 0)
+		{
+			for (auto& field : fields)
+			{
+				uint64_t* structMember = (uint64_t*)(listCursor + field.offset);
+				*structMember = *structMember == (uint64_t)-1 ? 0 : field.listStart + *structMember * field.structSize;
+			}
+			listCursor += struct_size;
+		}
+	}
+
 	std::string getMovesetNameFromFilename(const std::wstring& filename)
 	{
 		size_t lastSlash = filename.find_last_of(L"/\\");
@@ -198,33 +456,75 @@ namespace Helpers
 		return (stat(name, &buffer) == 0);
 	}
 
-	uint32_t crc32_update(const uint32_t(&table)[256], uint32_t initial, const void* buf, size_t len)
+	uint32_t crc32_update(uint32_t initial, const void* buf, size_t len)
 	{
+		const auto& table = GetCrc32Tables();
 		uint32_t c = initial ^ 0xFFFFFFFF;
 		const uint8_t* u = static_cast<const uint8_t*>(buf);
-		for (size_t i = 0; i < len; ++i) {
-			c = table[(c ^ u[i]) & 0xFF] ^ (c >> 8);
+
+		// Slice-by-8: process 8 bytes per iteration with 8 table lookups instead of 8 dependent ones
+		while (len >= 8)
+		{
+			uint32_t one;
+			uint32_t two;
+			memcpy(&one, u, sizeof(one));
+			memcpy(&two, u + 4, sizeof(two));
+			one ^= c;
+
+			c = table[7][one & 0xFF] ^ table[6][(one >> 8) & 0xFF] ^ table[5][(one >> 16) & 0xFF] ^ table[4][one >> 24] ^
+				table[3][two & 0xFF] ^ table[2][(two >> 8) & 0xFF] ^ table[1][(two >> 16) & 0xFF] ^ table[0][two >> 24];
+
+			u += 8;
+			len -= 8;
+		}
+
+		while (len-- > 0) {
+			c = table[0][(c ^ *u++) & 0xFF] ^ (c >> 8);
 		}
+
 		return c ^ 0xFFFFFFFF;
 	}
 
-	void crc32_generate_table(uint32_t(&table)[256])
+	uint32_t crc32_combine(uint32_t crc1, uint32_t crc2, uint64_t len2)
 	{
-		const uint32_t polynomial = 0xEDB88320;
-		for (uint32_t i = 0; i < 256; i++)
+		if (len2 == 0) {
+			return crc1;
+		}
+
+		// Appending [len2] zero bytes to crc1 is done by applying a 32x32 GF(2) matrix, squared for every bit of [len2]
+		uint32_t even[32];
+		uint32_t odd[32];
+
+		// Operator for one zero bit
+		odd[0] = 0xEDB88320;
+		for (unsigned int n = 1; n < 32; ++n) {
+			odd[n] = 1u << (n - 1);
+		}
+
+		// Operator for two then four zero bits
+		gf2_matrix_square(even, odd);
+		gf2_matrix_square(odd, even);
+
+		do
 		{
-			uint32_t c = i;
-			for (size_t j = 0; j < 8; j++)
-			{
-				if (c & 1) {
-					c = polynomial ^ (c >> 1);
-				}
-				else {
-					c >>= 1;
-				}
+			gf2_matrix_square(even, odd);
+			if (len2 & 1) {
+				crc1 = gf2_matrix_times(even, crc1);
 			}
-			table[i] = c;
-		}
+			len2 >>= 1;
+
+			if (len2 == 0) {
+				break;
+			}
+
+			gf2_matrix_square(odd, even);
+			if (len2 & 1) {
+				crc1 = gf2_matrix_times(odd, crc1);
+			}
+			len2 >>= 1;
+		} while (len2 != 0);
+
+		return crc1 ^ crc2;
 	}
 
 	bool VersionGreater(const char* version1, const char* version2)
@@ -393,4 +693,67 @@ namespace Helpers
 		while (*str == ' ') ++str;
 		return *str == '\0';
 	}
+
+	// Amount of threads started by ParallelFor() or reserved through ReserveThreads() that are currently running
+	static std::atomic<unsigned int> g_reservedThreads = 0;
+
+	unsigned int ReserveThreads(unsigned int wanted)
+	{
+		// The thread calling us is already running and isn't counted
+		static const unsigned int maxReservedThreads = std::max(1u, std::thread::hardware_concurrency()) - 1;
+
+		unsigned int reserved = g_reservedThreads.load();
+		unsigned int obtained;
+		do {
+			unsigned int available = reserved < maxReservedThreads ? maxReservedThreads - reserved : 0;
+			obtained = std::min(wanted, available);
+		} while (obtained != 0 && !g_reservedThreads.compare_exchange_weak(reserved, reserved + obtained));
+
+		return obtained;
+	}
+
+	void ReleaseThreads(unsigned int amount)
+	{
+		g_reservedThreads -= amount;
+	}
+
+	void ParallelFor(size_t count, const std::function<void(size_t)>& func, unsigned int maxThreads)
+	{
+		if (maxThreads == 0) {
+			maxThreads = std::max(1u, std::thread::hardware_concurrency());
+		}
+
+		// Only start the threads that the budget allows, the calling thread always works
+		size_t threadCount = std::min((size_t)maxThreads, count);
+		unsigned int extraThreads = threadCount > 1 ? ReserveThreads((unsigned int)threadCount - 1) : 0;
+		threadCount = (size_t)extraThreads + 1;
+
+		if (threadCount <= 1) {
+			for (size_t i = 0; i < count; ++i) {
+				func(i);
+			}
+			return;
+		}
+
+		// Every worker picks the next index to work on, which keeps them all busy even when calls have uneven durations
+		std::atomic<size_t> nextIndex = 0;
+		auto worker = [&]() {
+			for (size_t i = nextIndex++; i < count; i = nextIndex++) {
+				func(i);
+			}
+		};
+
+		std::vector<std::thread> threads;
+		for (size_t i = 1; i < threadCount; ++i) {
+			threads.push_back(std::thread(worker));
+		}
+
+		// The calling thread works too instead of idly waiting
+		worker();
+
+		for (auto& t : threads) {
+			t.join();
+		}
+		ReleaseThreads(extraThreads);
+	}
 }
@@ -4,8 +4,11 @@
 #include <string>
 #include <iterator>
 #include <algorithm>
+#include <functional>
 #include <vector>
+#include <initializer_list>
 #include <stdlib.h>
+#include <stddef.h>
 
 #include "GameTypes.h"
 
@@ -166,10 +169,93 @@ namespace ByteswapHelpers
 	void SWAP_INT64(void* x);
 }
 
+// Describes a big-endian member of a structure (or an array of them)
+struct ByteswapField
+{
+	// Offset of the member within its structure
+	uint32_t offset;
+	// Size of the value to swap : 2, 4 or 8
+	uint32_t size;
+	// Amount of consecutive values to swap, for array members
+	uint32_t count;
+};
+
+# define BYTESWAP_FIELD(type, member) ByteswapField{ offsetof(type, member), sizeof(type::member), 1 }
+# define BYTESWAP_ARRAY(type, member) ByteswapField{ offsetof(type, member), sizeof(type::member[0]), _countof(type::member) }
+
+namespace ByteswapHelpers
+{
+	// Returns true if every member has a swappable size (2, 4 or 8), fits within the structure and doesn't overlap another one
+	// Meant to be static_assert()'ed next to every layout
+	template<size_t N>
+	constexpr bool IsValidLayout(uint64_t structSize, const ByteswapField(&fields)[N])
+	{
+		for (size_t i = 0; i < N; ++i)
+		{
+			const ByteswapField& a = fields[i];
+			const uint64_t aEnd = a.offset + (uint64_t)a.size * a.count;
+
+			if ((a.size != 2 && a.size != 4 && a.size != 8) || a.count == 0 || aEnd > structSize) {
+				return false;
+			}
+
+			for (size_t j = i + 1; j < N; ++j)
+			{
+				const ByteswapField& b = fields[j];
+				const uint64_t bEnd = b.offset + (uint64_t)b.size * b.count;
+				if (a.offset < bEnd && b.offset < aEnd) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+}
+
+// Byte permutation of a structure, built once from the list of its big-endian members
+// Whole lists of structures are then swapped 16 bytes at a time with SSSE3 shuffles
+class ByteswapLayout
+{
+private:
+	// Size of the described structure
+	uint64_t m_structSize;
+	// The members to swap, used when shuffles can't be
+	std::vector<ByteswapField> m_fields;
+	// For every byte of the structure rounded up to 16 bytes: the byte it is read from, relative to the start of its 16 bytes chunk
+	std::vector<Byte> m_shuffleMasks;
+	// Chunks containing at least one member to swap, the others are left untouched
+	std::vector<uint32_t> m_chunks;
+	// False if a member crosses a 16 bytes boundary, or if the CPU doesn't support SSSE3
+	bool m_canShuffle = true;
+
+	void SwapWithShuffles(Byte* list, uint64_t amount) const;
+	void SwapScalar(Byte* list, uint64_t amount) const;
+public:
+	// The shuffles are checked against per-member swaps on construction, and not used if they don't match
+	ByteswapLayout(uint64_t structSize, const ByteswapField* fields, size_t fieldCount);
+	ByteswapLayout(uint64_t structSize, std::initializer_list<ByteswapField> fields) : ByteswapLayout(structSize, fields.begin(), fields.size()) {}
+	template<size_t N>
+	ByteswapLayout(uint64_t structSize, const ByteswapField(&fields)[N]) : ByteswapLayout(structSize, fields, N) {}
+
+	// Swaps the members of [amount] contiguous structures starting at [list]
+	void Swap(void* list, uint64_t amount) const;
+};
+
 class MovesetFile_BadSize : public std::exception{};
 class MovesetFile_AllocationError : public std::exception{};
 class MovesetFile_InvalidHeader : public std::exception{};
 
+// Describes a ptr member of a structure, and the list of structures it points into
+struct StructPtrField
+{
+	// Offset of the 64-bit member within its structure
+	uint64_t offset;
+	// Address of the first structure of the list pointed into
+	uint64_t listStart;
+	// Size of the structures of the list pointed into
+	uint64_t structSize;
+};
+
 namespace Helpers
 {
 
@@ -201,6 +287,11 @@ namespace Helpers
     // In a (moveset) list, can convert ptr members of every structure in the list into offsets
     void convertPtrsToOffsets(void* listAddr, uint64_t to_substract, uint64_t struct_size, uint64_t amount);
 
+    // In a (moveset) list, converts the given ptr members of every structure into indexes within the lists they point into. NULL ptrs become -1.
+    void convertPtrsToIndexes(void* listAddr, uint64_t struct_size, uint64_t amount, std::initializer_list<StructPtrField> fields);
+    // In a (moveset) list, converts the given index members of every structure back into ptrs. -1 indexes become NULL.
+    void convertIndexesToPtrs(void* listAddr, uint64_t struct_size, uint64_t amount, std::initializer_list<StructPtrField> fields);
+
     // Returns true if a string ends with [suffix]
 	template<typename T>
 	bool endsWith(const T& str, const T& suffix)
@@ -250,9 +341,9 @@ namespace Helpers
     bool fileExists(const char* name);
 
     // Update a crc32 with new data
-    uint32_t crc32_update(const uint32_t(&table)[256], uint32_t initial, const void* buf, size_t len);
-    // Create a table required for the crc32 generation
-    void crc32_generate_table(uint32_t(&table)[256]);
+    uint32_t crc32_update(uint32_t initial, const void* buf, size_t len);
+    // Returns the crc32 of two concatenated pieces of data, from their respective crc32 and the size of the second one
+    uint32_t crc32_combine(uint32_t crc1, uint32_t crc2, uint64_t len2);
 
 	// Returns true if version1 is greater than version2
 	bool VersionGreater(const char* version1, const char* version2);
@@ -266,4 +357,13 @@ namespace Helpers
 
 	// Returns true if the string is comprised of digits only. Ignores leading and trailing spaces.
 	bool is_string_digits(const char* str);
+
+	// Calls [func] for every index from 0 to [count] across a pool of worker threads, returns once every call is finished
+	// [maxThreads] at 0 uses as many threads as there are hardware threads
+	// Worker threads are taken from a process-wide budget of one per hardware thread, nested calls get what remains of it
+	void ParallelFor(size_t count, const std::function<void(size_t)>& func, unsigned int maxThreads = 0);
+	// Takes up to [wanted] threads from the budget shared with ParallelFor(), returns the amount obtained
+	unsigned int ReserveThreads(unsigned int wanted);
+	// Gives back threads obtained through ReserveThreads()
+	void ReleaseThreads(unsigned int amount);
 }
\ No newline at end of file
@@ -1,10 +1,14 @@
 ﻿#include <windows.h>
 #include <filesystem>
 #include <fstream>
+#include <chrono>
+#include <format>
 
 #include "Helpers.hpp"
 #include "GameProcess.hpp"
+#include "GameAddressesFile.hpp"
 #include "AnimExtractors.hpp"
+#include "Games.hpp"
 
 #include "constants.h"
 
@@ -165,6 +169,64 @@ static void MoveAnimationFile(const std::wstring& argFile)
 	}
 }
 
+// Appends a line to the report file of a snapshot replay
+// Release builds have no console, so the results of a replay always go to [snapshot].replay.txt
+static void WriteReplayReport(const std::wstring& argFile, const std::string& line)
+{
+	DEBUG_LOG("%s\n", line.c_str());
+
+	std::ofstream report(std::filesystem::path(argFile + L".replay.txt"), std::ios::app);
+	if (report.fail()) {
+		DEBUG_ERR("Failed to open the replay report of '%S'", argFile.c_str());
+		return;
+	}
+	report << line << std::endl;
+}
+
+// Runs an extraction on a recorded snapshot instead of the game, and measures how long it takes
+static void ReplayExtraction(const std::wstring& argFile)
+{
+	DEBUG_LOG("Replaying extraction snapshot '%S'\n", argFile.c_str());
+
+	GameProcessSnapshot* snapshot = new GameProcessSnapshot;
+	if (!snapshot->Load(argFile)) {
+		WriteReplayReport(argFile, "Failed to load the snapshot");
+		delete snapshot;
+		return;
+	}
+
+	const GameInfo* gameInfo = Games::GetGameInfoFromIdentifier(snapshot->gameId, snapshot->minorVersion);
+	if (gameInfo == nullptr) {
+		WriteReplayReport(argFile, std::format("Snapshot game ({}, minor {}) is not supported", snapshot->gameId, snapshot->minorVersion));
+		delete snapshot;
+		return;
+	}
+
+	gameAddr playerAddress = snapshot->playerAddress;
+	ExtractSettings settings = snapshot->extractSettings;
+	uint64_t baseAddr = snapshot->baseAddr;
+
+	GameAddressesFile addrFile;
+	GameProcess process;
+	GameData game;
+
+	process.AttachToSnapshot(snapshot);
+	game.SetProcess(&process, &addrFile);
+	game.SetCurrentGame(gameInfo);
+	// The base address may have been obtained through reads that happened before the recording
+	game.baseAddr = baseAddr;
+
+	Extractor* extractor = Games::FactoryGetExtractor(gameInfo, process, game);
+
+	std::atomic<uint8_t> progress = 0;
+	auto start = std::chrono::steady_clock::now();
+	ExtractionErrcode_ err = extractor->Extract(playerAddress, settings, progress);
+	auto end = std::chrono::steady_clock::now();
+
+	WriteReplayReport(argFile, std::format("Replayed extraction: errcode {}, {} ms", (unsigned int)err, std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()));
+	delete extractor;
+}
+
 bool handle_arguments()
 {
 	auto cmdLine = GetCommandLineW();
@@ -184,6 +246,13 @@ bool handle_arguments()
 				MoveAnimationFile(argv[2]);
 			}
 		}
+		else if (first_arg == L"--replay-extraction") {
+			if (argc >= 3) {
+				ReplayExtraction(argv[2]);
+			}
+			// Never start the GUI for this
+			return true;
+		}
 
 		DWORD currPid = GetCurrentProcessId();
 		for (auto& process : GameProcessUtils::GetRunningProcessList())